@@ -0,0 +1,12 @@
+# Performance benchmark suite for dux.
+#
+# `tests/` covers correctness only; this package measures throughput so a
+# walker or matcher change can be judged before it meets a production
+# volume.  It generates reproducible synthetic trees (synth.py), runs the
+# hot kernels and end-to-end scans against them (suite.py), and reports
+# entries/sec with regression comparison between saved runs (cli.py,
+# installed as the `dux-bench` entry point).
+#
+# Everything here is deterministic: tree generation and path corpora are
+# seeded, and each case reports the best of N repeats, so two runs on the
+# same machine are directly comparable.
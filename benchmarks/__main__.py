@@ -0,0 +1,6 @@
+# `python -m benchmarks` — same as the dux-bench entry point.
+import sys
+
+from benchmarks.cli import main
+
+sys.exit(main())
@@ -0,0 +1,149 @@
+# `dux-bench` entry point: generate, run, report, compare.
+#
+# Deliberately dependency-free (argparse + plain print): benchmarks are
+# often run in minimal environments and their output ends up in commit
+# messages and CI logs, where Rich markup would be noise.
+#
+# Typical use:
+#   dux-bench --profile many-small --scale 2 --save baseline.json
+#   ... make the change ...
+#   dux-bench --profile many-small --scale 2 --compare baseline.json
+
+from __future__ import annotations
+
+import argparse
+import json
+import os
+import shutil
+import sys
+import tempfile
+import time
+
+from benchmarks.suite import (
+    BenchResult,
+    bench_ac,
+    bench_finalize,
+    bench_prefix_trie,
+    bench_scan_sweep,
+    bench_walkers,
+)
+from benchmarks.synth import PROFILES, generate
+
+# Regressions smaller than this are treated as run-to-run noise.
+_NOISE_THRESHOLD = 0.05
+
+
+def _default_root() -> str:
+    # Prefer tmpfs so tree generation and walking measure CPU, not disk.
+    base = "/dev/shm" if os.path.isdir("/dev/shm") else tempfile.gettempdir()
+    return tempfile.mkdtemp(prefix="dux-bench-", dir=base)
+
+
+def _run_cases(args: argparse.Namespace, tree_root: str) -> list[BenchResult]:
+    results: list[BenchResult] = []
+
+    def wanted(name: str) -> bool:
+        return not args.only or any(sub in name for sub in args.only)
+
+    for result in bench_walkers(tree_root, repeats=args.repeats):
+        if wanted(result.name):
+            results.append(result)
+    for result in bench_ac(args.corpus, repeats=args.repeats):
+        if wanted(result.name):
+            results.append(result)
+    for result in bench_prefix_trie(args.corpus, repeats=args.repeats):
+        if wanted(result.name):
+            results.append(result)
+    for result in bench_finalize(args.scale, repeats=args.repeats):
+        if wanted(result.name):
+            results.append(result)
+    if wanted("scan/"):
+        workers = [int(w) for w in args.workers.split(",")]
+        for result in bench_scan_sweep(tree_root, workers, repeats=args.repeats):
+            if wanted(result.name):
+                results.append(result)
+    return results
+
+
+def _report(results: list[BenchResult], baseline: dict[str, dict[str, float]] | None) -> int:
+    width = max(len(r.name) for r in results)
+    header = f"{'case':<{width}}  {'entries':>10}  {'seconds':>9}  {'entries/s':>12}"
+    if baseline is not None:
+        header += f"  {'vs baseline':>12}"
+    print(header)
+    print("-" * len(header))
+
+    regressed = 0
+    for r in results:
+        line = f"{r.name:<{width}}  {r.entries:>10,}  {r.seconds:>9.4f}  {r.eps:>12,.0f}"
+        if baseline is not None:
+            old = baseline.get(r.name)
+            if old is None or not old.get("eps"):
+                line += f"  {'(new)':>12}"
+            else:
+                delta = r.eps / old["eps"] - 1.0
+                line += f"  {delta:>+11.1%}"
+                if delta < -_NOISE_THRESHOLD:
+                    line += "  REGRESSED"
+                    regressed += 1
+        print(line)
+    return regressed
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(
+        prog="dux-bench", description="dux performance benchmark suite"
+    )
+    parser.add_argument(
+        "--profile",
+        choices=sorted(PROFILES),
+        default="many-small",
+        help="synthetic tree profile for the walker and scan cases",
+    )
+    parser.add_argument("--scale", type=float, default=1.0, help="tree/corpus size multiplier")
+    parser.add_argument(
+        "--root", default=None, help="directory to build the tree in (default: tmpfs tempdir)"
+    )
+    parser.add_argument("--corpus", type=int, default=50_000, help="matcher corpus size (paths)")
+    parser.add_argument("--repeats", type=int, default=3, help="repeats per case (best is kept)")
+    parser.add_argument("--workers", default="1,2,4,8", help="worker counts for the scan sweep")
+    parser.add_argument("--only", action="append", help="run only cases whose name contains this")
+    parser.add_argument("--save", metavar="PATH", help="write results as JSON for later --compare")
+    parser.add_argument("--compare", metavar="PATH", help="baseline JSON from a previous --save")
+    args = parser.parse_args(argv)
+
+    owns_root = args.root is None
+    tree_root = args.root or _default_root()
+    try:
+        t0 = time.perf_counter()
+        stats = generate(args.profile, tree_root, args.scale)
+        print(
+            f"generated {args.profile} tree: {stats.files:,} files, "
+            f"{stats.directories:,} dirs in {time.perf_counter() - t0:.1f}s at {tree_root}"
+        )
+
+        baseline = None
+        if args.compare:
+            with open(args.compare, encoding="utf-8") as f:
+                baseline = json.load(f)
+
+        results = _run_cases(args, tree_root)
+        regressed = _report(results, baseline)
+
+        if args.save:
+            payload = {
+                r.name: {"entries": r.entries, "seconds": r.seconds, "eps": r.eps}
+                for r in results
+            }
+            with open(args.save, "w", encoding="utf-8") as f:
+                json.dump(payload, f, indent=2, sort_keys=True)
+            print(f"results written to {args.save}")
+
+        return 1 if regressed else 0
+    finally:
+        if owns_root:
+            shutil.rmtree(tree_root, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
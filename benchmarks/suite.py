@@ -0,0 +1,196 @@
+# Benchmark cases: hot kernels in isolation, then end-to-end scans.
+#
+# Every case reports BenchResult(entries, seconds) where `entries` is the
+# natural unit of work (directory entries walked, paths matched, nodes
+# finalized), so entries/sec is comparable across runs of the same case
+# even when the synthetic tree scale changes.  Timings are best-of-N:
+# the minimum is the least noisy estimator of the true cost on an
+# otherwise idle machine.
+
+from __future__ import annotations
+
+import sys
+import time
+from collections.abc import Callable, Iterator
+from dataclasses import dataclass
+from random import Random
+
+from dux._ac_matcher import AhoCorasick
+from dux._prefix_trie import PrefixTrie
+from dux.models.enums import NodeKind
+from dux.models.scan import ScanNode, ScanOptions
+from dux.scan.native_scanner import NativeScanner
+from dux.services.tree import LEAF_CHILDREN, finalize_sizes
+
+from benchmarks.synth import path_corpus
+
+
+@dataclass(slots=True, frozen=True)
+class BenchResult:
+    name: str
+    entries: int
+    seconds: float
+
+    @property
+    def eps(self) -> float:
+        """Entries per second."""
+        return self.entries / self.seconds if self.seconds else 0.0
+
+
+def _best_of(repeats: int, run: Callable[[], int]) -> tuple[int, float]:
+    entries = 0
+    best = float("inf")
+    for _ in range(repeats):
+        t0 = time.perf_counter()
+        entries = run()
+        best = min(best, time.perf_counter() - t0)
+    return entries, best
+
+
+# -- walkers ---------------------------------------------------------------
+
+def _walker_fns() -> list[tuple[str, object]]:
+    """The per-directory scan functions available on this platform."""
+    import dux._walker as walker
+
+    names = ["scan_dir_nodes"]
+    if sys.platform.startswith("linux"):
+        names.append("scan_dir_statx_nodes")
+    if sys.platform == "darwin":
+        names.append("scan_dir_bulk_nodes")
+    return [(n, getattr(walker, n)) for n in names if hasattr(walker, n)]
+
+
+def bench_walkers(tree_root: str, repeats: int = 3) -> Iterator[BenchResult]:
+    """Single-threaded BFS over the tree with each available C walker.
+
+    One thread isolates the per-call walker cost from the work queue and
+    GIL-release effects measured by the end-to-end case.
+    """
+    for name, scan_fn in _walker_fns():
+        def run() -> int:
+            root = ScanNode.directory(tree_root)
+            pending = [root]
+            entries = 0
+            while pending:
+                node = pending.pop()
+                dirs, files, n_dirs, _errs = scan_fn(  # type: ignore[operator]
+                    node.path, node, LEAF_CHILDREN,
+                    NodeKind.DIRECTORY, NodeKind.FILE, ScanNode,
+                    None, 0, None,
+                )
+                entries += files + n_dirs
+                pending.extend(dirs)
+            return entries
+
+        entries, seconds = _best_of(repeats, run)
+        yield BenchResult(f"walker/{name}", entries, seconds)
+
+
+# -- matchers --------------------------------------------------------------
+
+# Literal fragments of the kind the default CONTAINS/ENDSWITH rules
+# compile down to — enough words that the automaton has real breadth.
+_AC_WORDS = [
+    "node_modules/", ".cache/", "__pycache__/", "/build/", "/dist/",
+    "/target/", ".venv/", "/tmp/", ".log", ".tmp", ".pyc", ".o",
+    ".tar.gz", ".bak", "cache", "vendor/",
+]
+_PREFIX_WORDS = ["tmp", "cache", ".cache", "build", "core.", "npm-debug", "~", ".#"]
+
+
+def bench_ac(corpus_size: int, repeats: int = 3) -> Iterator[BenchResult]:
+    paths = path_corpus(corpus_size)
+    ac = AhoCorasick()
+    for i, word in enumerate(_AC_WORDS):
+        ac.add_word(word, i)
+    ac.make_automaton()
+
+    def run_iter() -> int:
+        for path in paths:
+            ac.iter(path)
+        return len(paths)
+
+    def run_iter_many() -> int:
+        ac.iter_many(paths)
+        return len(paths)
+
+    entries, seconds = _best_of(repeats, run_iter)
+    yield BenchResult("matcher/ac_iter", entries, seconds)
+    entries, seconds = _best_of(repeats, run_iter_many)
+    yield BenchResult("matcher/ac_iter_many", entries, seconds)
+
+
+def bench_prefix_trie(corpus_size: int, repeats: int = 3) -> Iterator[BenchResult]:
+    # The trie matches basenames, so feed it the corpus's final segments.
+    basenames = [p.rsplit("/", 1)[1] for p in path_corpus(corpus_size)]
+    trie = PrefixTrie()
+    for i, word in enumerate(_PREFIX_WORDS):
+        trie.add_prefix(word, i)
+    trie.build()
+
+    def run() -> int:
+        for name in basenames:
+            trie.iter(name)
+        return len(basenames)
+
+    entries, seconds = _best_of(repeats, run)
+    yield BenchResult("matcher/prefix_trie_iter", entries, seconds)
+
+
+# -- finalize --------------------------------------------------------------
+
+def _build_tree(fanout: int, depth: int, files_per_dir: int) -> tuple[ScanNode, int]:
+    rng = Random("dux-bench/finalize")
+    root = ScanNode.directory("/bench")
+    count = 1
+    frontier = [root]
+    for _ in range(depth):
+        next_frontier: list[ScanNode] = []
+        for parent in frontier:
+            for i in range(files_per_dir):
+                parent.children.append(
+                    ScanNode.file(f"f{i}", rng.randrange(0, 1 << 20), rng.randrange(0, 1 << 20), parent=parent)
+                )
+            for i in range(fanout):
+                child = ScanNode.directory(f"d{i}", parent=parent)
+                parent.children.append(child)
+                next_frontier.append(child)
+            count += files_per_dir + fanout
+        frontier = next_frontier
+    return root, count
+
+
+def bench_finalize(scale: float = 1.0, repeats: int = 3) -> Iterator[BenchResult]:
+    # Tree building is excluded from the timing; rebuilt per repeat so
+    # finalize never runs on its own already-sorted output.
+    depth = 4 if scale >= 0.5 else 3
+    entries = 0
+    best = float("inf")
+    for _ in range(repeats):
+        root, count = _build_tree(fanout=8, depth=depth, files_per_dir=6)
+        t0 = time.perf_counter()
+        finalize_sizes(root)
+        best = min(best, time.perf_counter() - t0)
+        entries = count
+    yield BenchResult("tree/finalize_sizes", entries, best)
+
+
+# -- end to end ------------------------------------------------------------
+
+def bench_scan_sweep(
+    tree_root: str, workers_list: list[int], repeats: int = 3
+) -> Iterator[BenchResult]:
+    """NativeScanner.scan across worker counts — the headline number."""
+    from dux._walker import scan_dir_nodes
+
+    for workers in workers_list:
+        scanner = NativeScanner(scan_dir_nodes, workers=workers)
+
+        def run() -> int:
+            result = scanner.scan(tree_root, ScanOptions())
+            snapshot = result.unwrap()
+            return snapshot.stats.files + snapshot.stats.directories
+
+        entries, seconds = _best_of(repeats, run)
+        yield BenchResult(f"scan/native_w{workers}", entries, seconds)
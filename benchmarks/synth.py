@@ -0,0 +1,148 @@
+# Reproducible synthetic filesystem trees and path corpora.
+#
+# Each profile stresses a different axis of the scanners:
+#   wide           — few levels, huge sibling lists (directory read cost)
+#   deep           — long parent chains (per-level overhead, path joining)
+#   many-small     — balanced tree of tiny files (per-entry overhead)
+#   hardlink-heavy — many multi-link inodes (InodeSet pressure)
+#
+# Files are created sparse (open + truncate) so generating a tree costs
+# metadata operations only — point --root at tmpfs and even the large
+# scales build in seconds.  Generation is seeded per profile, so the same
+# (profile, scale) pair always yields the identical tree.
+
+from __future__ import annotations
+
+import os
+import random
+from dataclasses import dataclass
+
+
+@dataclass(slots=True, frozen=True)
+class GenStats:
+    """What a generator produced: the denominator for entries/sec."""
+
+    files: int
+    directories: int
+
+
+def _touch(path: str, size: int) -> None:
+    with open(path, "wb") as f:
+        if size:
+            f.truncate(size)
+
+
+def _gen_wide(root: str, scale: float, rng: random.Random) -> GenStats:
+    # 2 levels: N dirs of M files each, sibling lists in the thousands.
+    n_dirs = max(2, int(40 * scale))
+    n_files = max(2, int(1500 * scale))
+    for d in range(n_dirs):
+        dir_path = os.path.join(root, f"wide{d:03d}")
+        os.mkdir(dir_path)
+        for f in range(n_files):
+            _touch(os.path.join(dir_path, f"f{f:05d}.dat"), rng.randrange(0, 65536))
+    return GenStats(files=n_dirs * n_files, directories=n_dirs)
+
+
+def _gen_deep(root: str, scale: float, rng: random.Random) -> GenStats:
+    # N independent chains, each `depth` levels with a couple of files per
+    # level.  Chain count rather than depth grows with scale: PATH_MAX
+    # bounds how deep a single chain can usefully go.
+    n_chains = max(1, int(30 * scale))
+    depth = 60
+    files = dirs = 0
+    for c in range(n_chains):
+        cur = os.path.join(root, f"chain{c:03d}")
+        os.mkdir(cur)
+        dirs += 1
+        for level in range(depth):
+            for f in range(2):
+                _touch(os.path.join(cur, f"f{f}.dat"), rng.randrange(0, 4096))
+                files += 1
+            cur = os.path.join(cur, f"d{level:02d}")
+            os.mkdir(cur)
+            dirs += 1
+    return GenStats(files=files, directories=dirs)
+
+
+def _gen_many_small(root: str, scale: float, rng: random.Random) -> GenStats:
+    # Balanced fanout-10 tree of zero-to-tiny files — the millions-of-
+    # small-files shape where per-entry overhead dominates.
+    n_top = max(2, int(25 * scale))
+    files = dirs = 0
+    for a in range(n_top):
+        for b in range(10):
+            dir_path = os.path.join(root, f"t{a:03d}", f"s{b}")
+            os.makedirs(dir_path)
+            for f in range(25):
+                _touch(os.path.join(dir_path, f"f{f:03d}"), rng.randrange(0, 512))
+                files += 1
+        dirs += 11
+    return GenStats(files=files, directories=dirs)
+
+
+def _gen_hardlink_heavy(root: str, scale: float, rng: random.Random) -> GenStats:
+    # A pool of real inodes, each linked into several directories — the
+    # dedup path must hit the InodeSet for most entries.
+    n_dirs = max(2, int(50 * scale))
+    pool_size = max(2, int(200 * scale))
+    links_per_dir = 40
+    pool_dir = os.path.join(root, ".pool")
+    os.mkdir(pool_dir)
+    pool: list[str] = []
+    for i in range(pool_size):
+        p = os.path.join(pool_dir, f"inode{i:04d}")
+        _touch(p, rng.randrange(1024, 262144))
+        pool.append(p)
+    files = pool_size
+    for d in range(n_dirs):
+        dir_path = os.path.join(root, f"proj{d:03d}")
+        os.mkdir(dir_path)
+        for j, src in enumerate(rng.sample(pool, min(links_per_dir, pool_size))):
+            os.link(src, os.path.join(dir_path, f"l{j:02d}"))
+            files += 1
+    return GenStats(files=files, directories=n_dirs + 1)
+
+
+PROFILES = {
+    "wide": _gen_wide,
+    "deep": _gen_deep,
+    "many-small": _gen_many_small,
+    "hardlink-heavy": _gen_hardlink_heavy,
+}
+
+
+def generate(profile: str, root: str, scale: float = 1.0) -> GenStats:
+    """Materialize *profile* under *root* (must exist and be empty)."""
+    gen = PROFILES.get(profile)
+    if gen is None:
+        raise ValueError(f"unknown profile {profile!r} (choose from {', '.join(PROFILES)})")
+    return gen(root, scale, random.Random(f"dux-bench/{profile}"))
+
+
+# Segment vocabulary for the matcher corpora, drawn from the path shapes
+# the default rules target (node_modules, caches, build output) mixed
+# with plain source trees, so matcher benchmarks see realistic hit rates
+# rather than all-miss or all-hit extremes.
+_DIR_VOCAB = [
+    "home", "work", "src", "lib", "app", "packages", "vendor", "docs",
+    "node_modules", ".cache", "__pycache__", "build", "dist", "target",
+    ".venv", "tmp", "assets", "internal", "api", "core", "utils",
+]
+_FILE_VOCAB = [
+    "index.js", "main.py", "mod.rs", "util.c", "data.json", "README.md",
+    "core.cpython-313.pyc", "app.log", "archive.tar.gz", "photo.jpeg",
+    "chunk.o", "lib.so", "notes.txt", "session.tmp", "cache.bin",
+]
+
+
+def path_corpus(n: int, seed: str = "dux-bench/corpus") -> list[str]:
+    """*n* deterministic absolute paths with realistic segment mixes."""
+    rng = random.Random(seed)
+    paths: list[str] = []
+    for _ in range(n):
+        depth = rng.randrange(2, 9)
+        segs = [rng.choice(_DIR_VOCAB) for _ in range(depth)]
+        segs.append(rng.choice(_FILE_VOCAB))
+        paths.append("/" + "/".join(segs))
+    return paths
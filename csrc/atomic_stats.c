@@ -0,0 +1,132 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdatomic.h>
+
+/*
+ * Atomic scan statistics counters.
+ *
+ * The scan hot path used a threading.Lock around the shared ScanStats
+ * dataclass; workers batched locally to amortize it, but progress reads
+ * took the same lock, so a TUI polling frequently stalled every worker.
+ * This object replaces the lock with C11 atomics: add() is a handful of
+ * relaxed fetch-adds, snapshot() is a wait-free read — neither can block
+ * another thread, with or without the GIL.
+ *
+ * Python API:
+ *   stats = AtomicStats()
+ *   stats.add(files, dirs, errors)
+ *   stats.snapshot() -> (files, dirs, errors)
+ *
+ * Relaxed ordering is sufficient: the counters are independent monotonic
+ * tallies, and the final read happens after the worker threads are
+ * joined (a full synchronization point).
+ */
+
+typedef struct {
+    PyObject_HEAD
+    _Atomic long long files;
+    _Atomic long long dirs;
+    _Atomic long long errors;
+} AtomicStatsObject;
+
+static PyObject *
+AtomicStats_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    (void)args;
+    (void)kwds;
+    AtomicStatsObject *self = (AtomicStatsObject *)type->tp_alloc(type, 0);
+    if (!self) return NULL;
+    atomic_init(&self->files, 0);
+    atomic_init(&self->dirs, 0);
+    atomic_init(&self->errors, 0);
+    return (PyObject *)self;
+}
+
+static void
+AtomicStats_dealloc(AtomicStatsObject *self)
+{
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+AtomicStats_add(AtomicStatsObject *self, PyObject *args)
+{
+    long long files, dirs, errors;
+    if (!PyArg_ParseTuple(args, "LLL", &files, &dirs, &errors))
+        return NULL;
+    if (files)
+        atomic_fetch_add_explicit(&self->files, files, memory_order_relaxed);
+    if (dirs)
+        atomic_fetch_add_explicit(&self->dirs, dirs, memory_order_relaxed);
+    if (errors)
+        atomic_fetch_add_explicit(&self->errors, errors, memory_order_relaxed);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+AtomicStats_snapshot(AtomicStatsObject *self, PyObject *Py_UNUSED(ignored))
+{
+    long long files = atomic_load_explicit(&self->files, memory_order_relaxed);
+    long long dirs = atomic_load_explicit(&self->dirs, memory_order_relaxed);
+    long long errors = atomic_load_explicit(&self->errors, memory_order_relaxed);
+    return Py_BuildValue("(LLL)", files, dirs, errors);
+}
+
+static PyMethodDef AtomicStats_methods[] = {
+    {"add", (PyCFunction)AtomicStats_add, METH_VARARGS,
+     "add(files, dirs, errors) — atomically add to the three counters"},
+    {"snapshot", (PyCFunction)AtomicStats_snapshot, METH_NOARGS,
+     "snapshot() -> (files, dirs, errors) — wait-free consistent-enough read"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject AtomicStatsType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "dux._atomic_stats.AtomicStats",
+    .tp_basicsize = sizeof(AtomicStatsObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Lock-free scan statistics counters (C11 atomics).",
+    .tp_new = AtomicStats_new,
+    .tp_dealloc = (destructor)AtomicStats_dealloc,
+    .tp_methods = AtomicStats_methods,
+};
+
+/* ------------------------------------------------------------------ */
+/* Module definition (multi-phase init for free-threaded compat)      */
+/* ------------------------------------------------------------------ */
+
+static int
+atomic_stats_exec(PyObject *m)
+{
+    if (PyType_Ready(&AtomicStatsType) < 0)
+        return -1;
+    if (PyModule_AddObjectRef(m, "AtomicStats",
+                              (PyObject *)&AtomicStatsType) < 0)
+        return -1;
+    return 0;
+}
+
+/* Thread-safety contract: every operation is a C11 atomic on plain
+ * counters — safe from any number of threads with no GIL involvement.
+ * This justifies Py_MOD_GIL_NOT_USED for free-threaded Python. */
+static PyModuleDef_Slot atomic_stats_slots[] = {
+    {Py_mod_exec, atomic_stats_exec},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+static struct PyModuleDef atomic_stats_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "dux._atomic_stats",
+    .m_doc = "Lock-free scan statistics counters (GIL-free).",
+    .m_size = 0,
+    .m_slots = atomic_stats_slots,
+};
+
+PyMODINIT_FUNC
+PyInit__atomic_stats(void)
+{
+    return PyModuleDef_Init(&atomic_stats_module);
+}
@@ -0,0 +1,355 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+/*
+ * Native filesystem-event watcher for dux watch mode.
+ *
+ * Wraps Linux inotify behind a small Watcher object:
+ *
+ *   w = Watcher()
+ *   wd = w.add(path)          (one watch per directory, IN_ONLYDIR)
+ *   w.remove(wd)
+ *   w.poll(timeout_ms) -> list[int]   (coalesced dirty watch descriptors)
+ *   w.fileno() / w.close()
+ *
+ * poll() waits in poll(2) and drains the kernel queue with the GIL
+ * released, deduplicating events into one entry per dirty directory —
+ * a burst of writes into the same directory costs the consumer a
+ * single rescan.  Queue overflow (the kernel dropped events) is
+ * surfaced as the OVERFLOW sentinel (-1) so the caller can fall back
+ * to refreshing everything it watches.
+ *
+ * Linux-only: on other platforms the module still imports but
+ * Watcher() raises OSError, and dux/services/watch.py degrades
+ * gracefully.  A macOS FSEvents backend would slot in behind the same
+ * four-method interface.
+ */
+
+#define FSW_OVERFLOW (-1)
+
+typedef struct {
+    PyObject_HEAD
+    int fd;  /* inotify instance, -1 once closed */
+} WatcherObject;
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/* Everything that changes a directory's direct contents or the sizes
+ * of the files in it.  IN_MODIFY is deliberately included: long-lived
+ * writers (growing logs) never emit IN_CLOSE_WRITE, and coalescing
+ * keeps the resulting rescans to one per poll anyway. */
+#define FSW_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | \
+                  IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | \
+                  IN_ONLYDIR | IN_EXCL_UNLINK)
+
+static PyObject *
+Watcher_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    (void)args; (void)kwds;
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        return PyErr_SetFromErrno(PyExc_OSError);
+    WatcherObject *self = (WatcherObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        close(fd);
+        return NULL;
+    }
+    self->fd = fd;
+    return (PyObject *)self;
+}
+
+static void
+Watcher_dealloc(WatcherObject *self)
+{
+    if (self->fd >= 0)
+        close(self->fd);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+watcher_check_open(WatcherObject *self)
+{
+    if (self->fd < 0) {
+        PyErr_SetString(PyExc_ValueError, "watcher is closed");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+Watcher_add(WatcherObject *self, PyObject *args)
+{
+    PyObject *path_obj;
+    if (!PyArg_ParseTuple(args, "U", &path_obj))
+        return NULL;
+    if (watcher_check_open(self) < 0)
+        return NULL;
+    const char *path = PyUnicode_AsUTF8(path_obj);
+    if (!path)
+        return NULL;
+
+    int wd;
+    Py_BEGIN_ALLOW_THREADS
+    wd = inotify_add_watch(self->fd, path, FSW_MASK);
+    Py_END_ALLOW_THREADS
+    if (wd < 0)
+        return PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+    return PyLong_FromLong(wd);
+}
+
+static PyObject *
+Watcher_remove(WatcherObject *self, PyObject *args)
+{
+    int wd;
+    if (!PyArg_ParseTuple(args, "i", &wd))
+        return NULL;
+    if (watcher_check_open(self) < 0)
+        return NULL;
+    /* EINVAL means the kernel already dropped the watch (the directory
+     * was deleted); that is exactly the state we want. */
+    if (inotify_rm_watch(self->fd, wd) < 0 && errno != EINVAL)
+        return PyErr_SetFromErrno(PyExc_OSError);
+    Py_RETURN_NONE;
+}
+
+static int
+fsw_cmp_int(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static PyObject *
+Watcher_poll(WatcherObject *self, PyObject *args)
+{
+    int timeout_ms = 0;
+    if (!PyArg_ParseTuple(args, "|i", &timeout_ms))
+        return NULL;
+    if (watcher_check_open(self) < 0)
+        return NULL;
+
+    int *wds = NULL;
+    size_t n_wds = 0, cap_wds = 0;
+    int overflow = 0, err = 0, oom = 0;
+
+    Py_BEGIN_ALLOW_THREADS
+    struct pollfd pfd = { .fd = self->fd, .events = POLLIN, .revents = 0 };
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    if (ready < 0)
+        err = errno;
+
+    while (ready > 0 && !oom) {
+        /* Big enough for one maximal event (sizeof + NAME_MAX + 1). */
+        char buf[16384] __attribute__((aligned(8)));
+        ssize_t len = read(self->fd, buf, sizeof(buf));
+        if (len <= 0) {
+            if (len < 0 && errno == EINTR)
+                continue;
+            if (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                err = errno;
+            break;  /* EAGAIN: queue drained */
+        }
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            p += sizeof(*ev) + ev->len;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                overflow = 1;
+                continue;
+            }
+            if (ev->mask & IN_IGNORED)
+                continue;
+            if (n_wds >= cap_wds) {
+                size_t new_cap = cap_wds ? cap_wds * 2 : 64;
+                int *tmp = (int *)realloc(wds, sizeof(int) * new_cap);
+                if (!tmp) {
+                    oom = 1;
+                    break;
+                }
+                wds = tmp;
+                cap_wds = new_cap;
+            }
+            wds[n_wds++] = ev->wd;
+        }
+    }
+
+    /* Coalesce: one entry per dirty directory regardless of how many
+     * events it produced. */
+    if (n_wds > 1) {
+        qsort(wds, n_wds, sizeof(int), fsw_cmp_int);
+        size_t out = 1;
+        for (size_t i = 1; i < n_wds; i++) {
+            if (wds[i] != wds[out - 1])
+                wds[out++] = wds[i];
+        }
+        n_wds = out;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (oom) {
+        free(wds);
+        return PyErr_NoMemory();
+    }
+    if (err) {
+        free(wds);
+        errno = err;
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    PyObject *result = PyList_New((Py_ssize_t)n_wds + (overflow ? 1 : 0));
+    if (!result) {
+        free(wds);
+        return NULL;
+    }
+    Py_ssize_t idx = 0;
+    if (overflow) {
+        PyObject *v = PyLong_FromLong(FSW_OVERFLOW);
+        if (!v) goto fail;
+        PyList_SET_ITEM(result, idx++, v);
+    }
+    for (size_t i = 0; i < n_wds; i++) {
+        PyObject *v = PyLong_FromLong(wds[i]);
+        if (!v) goto fail;
+        PyList_SET_ITEM(result, idx++, v);
+    }
+    free(wds);
+    return result;
+
+fail:
+    free(wds);
+    Py_DECREF(result);
+    return NULL;
+}
+
+static PyObject *
+Watcher_fileno(WatcherObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (watcher_check_open(self) < 0)
+        return NULL;
+    return PyLong_FromLong(self->fd);
+}
+
+static PyObject *
+Watcher_close(WatcherObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (self->fd >= 0) {
+        close(self->fd);
+        self->fd = -1;
+    }
+    Py_RETURN_NONE;
+}
+
+#else  /* !__linux__ */
+
+static PyObject *
+Watcher_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    (void)type; (void)args; (void)kwds;
+    PyErr_SetString(PyExc_OSError,
+                    "filesystem watching requires Linux inotify");
+    return NULL;
+}
+
+static void
+Watcher_dealloc(WatcherObject *self)
+{
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+fsw_unavailable(PyObject *self, PyObject *args)
+{
+    (void)self; (void)args;
+    PyErr_SetString(PyExc_OSError,
+                    "filesystem watching requires Linux inotify");
+    return NULL;
+}
+
+#define Watcher_add fsw_unavailable
+#define Watcher_remove fsw_unavailable
+#define Watcher_poll fsw_unavailable
+#define Watcher_fileno fsw_unavailable
+#define Watcher_close fsw_unavailable
+
+#endif  /* __linux__ */
+
+static PyMethodDef Watcher_methods[] = {
+    {"add", (PyCFunction)Watcher_add, METH_VARARGS,
+     "add(path) -> wd\n\n"
+     "Watch one directory (IN_ONLYDIR) for content and size changes.\n"
+     "Returns the watch descriptor events will carry."},
+    {"remove", (PyCFunction)Watcher_remove, METH_VARARGS,
+     "remove(wd) -> None\n\n"
+     "Drop a watch.  Already-gone watches (deleted directory) are fine."},
+    {"poll", (PyCFunction)Watcher_poll, METH_VARARGS,
+     "poll(timeout_ms=0) -> list[int]\n\n"
+     "Wait up to timeout_ms, then drain and coalesce the event queue\n"
+     "into unique dirty watch descriptors (GIL released throughout).\n"
+     "OVERFLOW (-1) in the result means events were dropped and every\n"
+     "watched directory should be treated as dirty."},
+    {"fileno", (PyCFunction)Watcher_fileno, METH_NOARGS,
+     "fileno() -> int — the inotify fd, for external event loops."},
+    {"close", (PyCFunction)Watcher_close, METH_NOARGS,
+     "close() -> None — release the inotify instance."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject WatcherType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "dux._fswatch.Watcher",
+    .tp_basicsize = sizeof(WatcherObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "inotify-backed directory watcher with coalesced batches.",
+    .tp_new = Watcher_new,
+    .tp_dealloc = (destructor)Watcher_dealloc,
+    .tp_methods = Watcher_methods,
+};
+
+/* ------------------------------------------------------------------ */
+/* Module definition (multi-phase init for free-threaded compat)      */
+/* ------------------------------------------------------------------ */
+
+static int
+fswatch_exec(PyObject *m)
+{
+    if (PyType_Ready(&WatcherType) < 0)
+        return -1;
+    if (PyModule_AddObjectRef(m, "Watcher", (PyObject *)&WatcherType) < 0)
+        return -1;
+    if (PyModule_AddIntConstant(m, "OVERFLOW", FSW_OVERFLOW) < 0)
+        return -1;
+    return 0;
+}
+
+/* Thread-safety contract: one Watcher is driven by one consumer; the
+ * kernel queue itself serializes concurrent event delivery. */
+static PyModuleDef_Slot fswatch_slots[] = {
+    {Py_mod_exec, fswatch_exec},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+static struct PyModuleDef fswatch_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "dux._fswatch",
+    .m_doc = "Native filesystem-event watcher (Linux inotify).",
+    .m_size = 0,
+    .m_slots = fswatch_slots,
+};
+
+PyMODINIT_FUNC
+PyInit__fswatch(void)
+{
+    return PyModuleDef_Init(&fswatch_module);
+}
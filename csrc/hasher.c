@@ -0,0 +1,283 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Batch content hashing for the duplicate-file finder.
+ *
+ * The dedup pipeline (services/duplicates.py) buckets candidate files by
+ * exact size straight from the scan tree, so the only new I/O is content
+ * confirmation.  That happens in two passes, both served here:
+ *
+ *   hash_sampled(paths) -> list[int | None]
+ *       Fingerprint from three 64 KiB blocks (head, middle, tail) plus
+ *       the file size.  Files spanning at most the three blocks are
+ *       hashed in full, so for them the sampled hash IS the full hash.
+ *   hash_full(paths) -> list[int | None]
+ *       Streamed hash of the entire content, for sampled-hash survivors.
+ *
+ * Both release the GIL for the whole batch; callers fan batches out over
+ * worker threads (the finalize_sizes_parallel pattern), which is how the
+ * rest of the scan pipeline parallelizes C work.  None marks a file that
+ * could not be opened or read — the caller drops it from its bucket.
+ *
+ * Reads go through a 4096-aligned buffer via pread at block-multiple
+ * offsets, so they stay friendly to direct I/O and never force the
+ * kernel into read-modify-write alignment fixups.  O_DIRECT itself is
+ * deliberately not set: it is refused by tmpfs/overlayfs and would turn
+ * warm-cache confirmation runs into device reads.
+ *
+ * The hash is FNV-1a over 64 bits — not cryptographic, but the pipeline
+ * only compares files that already agree on exact size (and, in the full
+ * pass, on the sampled fingerprint), so an accidental collision needs
+ * two same-sized different files colliding twice independently.
+ */
+
+#define SAMPLE_BLOCK (64 * 1024)
+/* Total content covered by hash_sampled; files at or below this size are
+ * fully covered and need no second pass. */
+#define SAMPLE_SPAN (3 * SAMPLE_BLOCK)
+#define FULL_BLOCK (256 * 1024)
+#define BUF_ALIGN 4096
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static inline uint64_t
+fnv1a(uint64_t h, const unsigned char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+/* pread exactly *len* bytes at *off* into *buf*; -1 on error/short read.
+ * Short reads only happen if the file shrank under us — treat as error
+ * so a truncated-mid-scan file never "confirms" as a duplicate. */
+static int
+read_block(int fd, unsigned char *buf, size_t len, off_t off)
+{
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = pread(fd, buf + got, len - got, off + (off_t)got);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR)
+                continue;
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return 0;
+}
+
+/* Hash head/middle/tail blocks (or everything, for small files).
+ * Returns 0 and the hash via *out, or -1 on any I/O error. */
+static int
+hash_one_sampled(const char *path, unsigned char *buf, uint64_t *out)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0)
+        return -1;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    off_t size = st.st_size;
+    /* Seed with the size so zero-length and hole-only reads of different
+     * lengths cannot coincide. */
+    uint64_t h = fnv1a(FNV_OFFSET, (const unsigned char *)&size, sizeof(size));
+
+    if (size <= SAMPLE_SPAN) {
+        off_t off = 0;
+        while (off < size) {
+            size_t want = (size_t)((size - off) < SAMPLE_BLOCK ? (size - off) : SAMPLE_BLOCK);
+            if (read_block(fd, buf, want, off) < 0) {
+                close(fd);
+                return -1;
+            }
+            h = fnv1a(h, buf, want);
+            off += (off_t)want;
+        }
+    } else {
+        /* Middle block rounded down to an aligned offset. */
+        off_t offsets[3];
+        offsets[0] = 0;
+        offsets[1] = ((size / 2) - SAMPLE_BLOCK / 2) & ~((off_t)BUF_ALIGN - 1);
+        offsets[2] = size - SAMPLE_BLOCK;
+        for (int i = 0; i < 3; i++) {
+            if (read_block(fd, buf, SAMPLE_BLOCK, offsets[i]) < 0) {
+                close(fd);
+                return -1;
+            }
+            h = fnv1a(h, buf, SAMPLE_BLOCK);
+        }
+    }
+    close(fd);
+    *out = h;
+    return 0;
+}
+
+static int
+hash_one_full(const char *path, unsigned char *buf, uint64_t *out)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0)
+        return -1;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    off_t size = st.st_size;
+    uint64_t h = fnv1a(FNV_OFFSET, (const unsigned char *)&size, sizeof(size));
+    off_t off = 0;
+    while (off < size) {
+        size_t want = (size_t)((size - off) < FULL_BLOCK ? (size - off) : FULL_BLOCK);
+        if (read_block(fd, buf, want, off) < 0) {
+            close(fd);
+            return -1;
+        }
+        h = fnv1a(h, buf, want);
+        off += (off_t)want;
+    }
+    close(fd);
+    *out = h;
+    return 0;
+}
+
+/* Shared driver for both entry points: decode the path list while
+ * holding the GIL, hash the whole batch without it, then build the
+ * result list. */
+static PyObject *
+hash_batch(PyObject *paths, int (*hash_one)(const char *, unsigned char *, uint64_t *))
+{
+    if (!PyList_Check(paths)) {
+        PyErr_SetString(PyExc_TypeError, "expected a list of paths");
+        return NULL;
+    }
+    Py_ssize_t n = PyList_GET_SIZE(paths);
+
+    PyObject **encoded = PyMem_Calloc((size_t)(n ? n : 1), sizeof(PyObject *));
+    uint64_t *hashes = PyMem_Malloc((size_t)(n ? n : 1) * sizeof(uint64_t));
+    char *ok = PyMem_Calloc((size_t)(n ? n : 1), 1);
+    if (!encoded || !hashes || !ok) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        encoded[i] = PyUnicode_EncodeFSDefault(PyList_GET_ITEM(paths, i));
+        if (!encoded[i])
+            goto fail;
+    }
+
+    unsigned char *buf = NULL;
+    if (posix_memalign((void **)&buf, BUF_ALIGN, FULL_BLOCK) != 0) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < n; i++) {
+        if (hash_one(PyBytes_AS_STRING(encoded[i]), buf, &hashes[i]) == 0)
+            ok[i] = 1;
+    }
+    Py_END_ALLOW_THREADS
+    free(buf);
+
+    PyObject *result = PyList_New(n);
+    if (!result)
+        goto fail;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item;
+        if (ok[i]) {
+            item = PyLong_FromUnsignedLongLong(hashes[i]);
+            if (!item) {
+                Py_DECREF(result);
+                goto fail;
+            }
+        } else {
+            item = Py_NewRef(Py_None);
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+    for (Py_ssize_t i = 0; i < n; i++)
+        Py_DECREF(encoded[i]);
+    PyMem_Free(encoded);
+    PyMem_Free(hashes);
+    PyMem_Free(ok);
+    return result;
+
+fail:
+    if (encoded) {
+        for (Py_ssize_t i = 0; i < n; i++)
+            Py_XDECREF(encoded[i]);
+        PyMem_Free(encoded);
+    }
+    PyMem_Free(hashes);
+    PyMem_Free(ok);
+    return NULL;
+}
+
+static PyObject *
+hasher_hash_sampled(PyObject *Py_UNUSED(module), PyObject *paths)
+{
+    return hash_batch(paths, hash_one_sampled);
+}
+
+static PyObject *
+hasher_hash_full(PyObject *Py_UNUSED(module), PyObject *paths)
+{
+    return hash_batch(paths, hash_one_full);
+}
+
+static PyMethodDef hasher_methods[] = {
+    {"hash_sampled", hasher_hash_sampled, METH_O,
+     "hash_sampled(paths) -> list[int | None] — head/middle/tail fingerprints"},
+    {"hash_full", hasher_hash_full, METH_O,
+     "hash_full(paths) -> list[int | None] — full-content hashes"},
+    {NULL, NULL, 0, NULL}
+};
+
+static int
+hasher_exec(PyObject *m)
+{
+    if (PyModule_AddIntConstant(m, "SAMPLE_SPAN", SAMPLE_SPAN) < 0)
+        return -1;
+    return 0;
+}
+
+/* Every batch works on a private buffer and private locals; nothing in
+ * this module is shared between calls, so concurrent batches from
+ * multiple threads are safe with or without the GIL. */
+static PyModuleDef_Slot hasher_slots[] = {
+    {Py_mod_exec, hasher_exec},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+static struct PyModuleDef hasher_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "dux._hasher",
+    .m_doc = "Batch sampled/full content hashing for duplicate detection.",
+    .m_methods = hasher_methods,
+    .m_size = 0,
+    .m_slots = hasher_slots,
+};
+
+PyMODINIT_FUNC
+PyInit__hasher(void)
+{
+    return PyModuleDef_Init(&hasher_module);
+}
@@ -0,0 +1,1678 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Native tiered pattern matcher: the whole CompiledRuleSet dispatch
+ * (EXACT hash -> Aho-Corasick -> prefix trie -> glob fallback ->
+ * additional paths) behind a single C call per node, so classification
+ * pays one Python->C transition instead of tier-by-tier glue.
+ *
+ * The object is populated by dux/services/patterns.py, which keeps the
+ * compile-time classification (brace expansion, pattern shapes) in
+ * Python where it belongs — only the per-node hot path lives here.
+ *
+ * Python API (kind: 0 = file rules, 1 = dir rules):
+ *   rs = CompiledRuleSetNative()
+ *   rs.add_exact(kind, key, rule, category)
+ *   rs.add_substring(kind, key, rule, category, end_only)
+ *   rs.add_prefix(kind, key, rule, category)
+ *   rs.add_glob(kind, pattern, rule, category)
+ *   rs.add_path(kind, base, rule, category)
+ *   rs.build()
+ *   rs.match(path, basename, is_dir) -> list[rule]
+ *   rs.match_many(items: list[(path, basename, is_dir)]) -> list[list[rule]]
+ *   rs.save(path)                       (flat binary dump of the built arrays)
+ *   rs.load(path, rules)                (mmap — skips classification + build)
+ *
+ * First match wins per category (categories are small ints, at most 64,
+ * tracked in a uint64 bitmask during matching), exactly mirroring the
+ * pure-Python match_all.
+ */
+
+#define RS_ALPHA 256
+#define RS_MAX_CATEGORIES 64
+
+/* One (rule, category) registration.  Every matcher key points at a
+ * singly-linked chain of these, in insertion order. */
+typedef struct {
+    PyObject *rule;  /* strong ref */
+    int category;    /* 0 .. RS_MAX_CATEGORIES-1 */
+    int end_only;    /* AC entries: fire only at the last path byte */
+    int next;        /* next entry in the same chain, -1 = end */
+} REntry;
+
+/* Aho-Corasick construction trie node (freed after build, same
+ * compaction scheme as csrc/ac_matcher.c). */
+typedef struct {
+    int children[RS_ALPHA];
+    int fail;
+    int out_head, out_tail;  /* REntry chain, -1 = none */
+    int dict_suffix;
+} ACTrieNode;
+
+/* Prefix trie node — kept fat at runtime; the walk is O(basename) and
+ * the trie holds only a handful of short keys. */
+typedef struct {
+    int children[RS_ALPHA];
+    int head, tail;  /* REntry chain, -1 = none */
+} PTrieNode;
+
+/* Compiled glob program: one op per pattern element, matched with the
+ * classic two-pointer star-backtracking walk.  Compiling once at
+ * add_glob time replaces per-call pattern re-parsing (fnmatch(3)) or
+ * regex-cache lookups (Python fnmatch) with a linear scan over a few
+ * dozen bytes of ops. */
+enum {
+    GOP_LIT = 0,    /* match exactly `lit` */
+    GOP_QMARK = 1,  /* match any single byte */
+    GOP_STAR = 2,   /* match any run of bytes, including '/' */
+    GOP_CLASS = 3,  /* match any byte whose bit is set in cls[] */
+};
+
+typedef struct {
+    unsigned char kind;
+    unsigned char lit;
+    uint32_t cls[8];  /* 256-bit membership set for GOP_CLASS */
+} GlobOp;
+
+typedef struct {
+    GlobOp *ops;
+    int n_ops;
+} GlobProg;
+
+/* fnmatch-style semantics: '*' and '?' cross '/', "[!...]" negates,
+ * ranges allowed, an unclosed '[' is a literal bracket. */
+static int
+glob_compile(const char *pat, Py_ssize_t plen, GlobProg *prog)
+{
+    GlobOp *ops = (GlobOp *)calloc((size_t)plen ? (size_t)plen : 1,
+                                   sizeof(GlobOp));
+    if (!ops) return -1;
+    int n = 0;
+
+    for (Py_ssize_t i = 0; i < plen; ) {
+        unsigned char c = (unsigned char)pat[i];
+        if (c == '*') {
+            /* Collapse runs of stars into one op. */
+            if (n == 0 || ops[n - 1].kind != GOP_STAR)
+                ops[n++].kind = GOP_STAR;
+            i++;
+        }
+        else if (c == '?') {
+            ops[n++].kind = GOP_QMARK;
+            i++;
+        }
+        else if (c == '[') {
+            /* Find the closing bracket; '!' negates, and a ']' right
+             * after the (possibly negated) opening is a literal. */
+            Py_ssize_t j = i + 1;
+            int neg = 0;
+            if (j < plen && pat[j] == '!') {
+                neg = 1;
+                j++;
+            }
+            if (j < plen && pat[j] == ']')
+                j++;
+            while (j < plen && pat[j] != ']')
+                j++;
+            if (j >= plen) {
+                /* Unclosed class: '[' is an ordinary character. */
+                ops[n].kind = GOP_LIT;
+                ops[n++].lit = '[';
+                i++;
+                continue;
+            }
+            GlobOp *op = &ops[n++];
+            op->kind = GOP_CLASS;
+            Py_ssize_t k = i + 1 + neg;
+            while (k < j) {
+                unsigned char lo = (unsigned char)pat[k];
+                unsigned char hi = lo;
+                if (k + 2 < j && pat[k + 1] == '-') {
+                    hi = (unsigned char)pat[k + 2];
+                    k += 3;
+                }
+                else {
+                    k++;
+                }
+                for (unsigned int b = lo; b <= hi; b++)
+                    op->cls[b >> 5] |= (uint32_t)1 << (b & 31);
+            }
+            if (neg) {
+                for (int w = 0; w < 8; w++)
+                    op->cls[w] = ~op->cls[w];
+            }
+            i = j + 1;
+        }
+        else {
+            ops[n].kind = GOP_LIT;
+            ops[n++].lit = c;
+            i++;
+        }
+    }
+
+    prog->ops = ops;
+    prog->n_ops = n;
+    return 0;
+}
+
+static int
+glob_run(const GlobProg *prog, const char *s, Py_ssize_t slen)
+{
+    const GlobOp *ops = prog->ops;
+    const int n_ops = prog->n_ops;
+    int pi = 0, star_pi = -1;
+    Py_ssize_t si = 0, star_si = 0;
+
+    while (si < slen) {
+        if (pi < n_ops) {
+            const GlobOp *op = &ops[pi];
+            unsigned char c = (unsigned char)s[si];
+            if (op->kind == GOP_STAR) {
+                /* Record the backtrack point; try the shortest match
+                 * first and extend on failure below. */
+                star_pi = pi++;
+                star_si = si;
+                continue;
+            }
+            if (op->kind == GOP_QMARK ||
+                (op->kind == GOP_LIT && c == op->lit) ||
+                (op->kind == GOP_CLASS &&
+                 (op->cls[c >> 5] >> (c & 31)) & 1)) {
+                pi++;
+                si++;
+                continue;
+            }
+        }
+        if (star_pi < 0)
+            return 0;
+        /* Backtrack: let the last star swallow one more byte. */
+        pi = star_pi + 1;
+        si = ++star_si;
+    }
+    while (pi < n_ops && ops[pi].kind == GOP_STAR)
+        pi++;
+    return pi == n_ops;
+}
+
+/* All matchers for one node kind (file or dir). */
+typedef struct {
+    /* EXACT: keys collected during construction, open-addressing hash
+     * built by build() so lookups are GIL-free. */
+    char **ex_keys;
+    Py_ssize_t *ex_lens;
+    int *ex_heads, *ex_tails;
+    int n_ex, cap_ex;
+    int *ex_slot;     /* slot -> exact index, -1 = empty */
+    size_t ex_mask;   /* n_slots - 1 (power of two), 0 when no keys */
+
+    /* Aho-Corasick (CONTAINS + ENDSWITH needles) */
+    ACTrieNode *ac_nodes;
+    int ac_n, ac_cap;
+    unsigned char charmap[RS_ALPHA];
+    int n_classes;
+    int *delta;    /* ac_n * n_classes full-DFA goto table */
+    int *ac_out;   /* per-state REntry chain head, -1 = none */
+    int *ac_dict;  /* per-state dict-suffix link, -1 = none */
+
+    /* STARTSWITH prefix trie */
+    PTrieNode *pt_nodes;
+    int pt_n, pt_cap;
+
+    /* GLOB fallback: programs compiled at add_glob time, run against
+     * path then basename; base_progs pre-strips a trailing
+     * slash-star-star so a dir pattern also matches the directory
+     * itself (mirrors _match_pattern_slow). */
+    GlobProg *gl_progs;
+    GlobProg *gl_base_progs;  /* ops == NULL when there is no such suffix */
+    int *gl_entries;
+    int n_gl, cap_gl;
+
+    /* Additional paths: literal base, matches base itself or base + "/" */
+    char **ap_bases;
+    Py_ssize_t *ap_lens;
+    int *ap_entries;
+    int n_ap, cap_ap;
+} KindSet;
+
+typedef struct {
+    PyObject_HEAD
+    REntry *entries;
+    int n_entries, cap_entries;
+    KindSet kinds[2];  /* [0] = file, [1] = dir */
+    int built;
+    /* Non-NULL for rulesets loaded via load(): the KindSet arrays point
+     * into this mapping and must not be free()d individually. */
+    void *map_base;
+    size_t map_len;
+} RuleSetObject;
+
+/* ------------------------------------------------------------------ */
+/* Small helpers                                                      */
+/* ------------------------------------------------------------------ */
+
+static uint32_t
+rs_hash(const char *s, Py_ssize_t len)
+{
+    uint32_t h = 2166136261u; /* FNV-1a */
+    for (Py_ssize_t i = 0; i < len; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static char *
+rs_strdup(const char *s, Py_ssize_t len)
+{
+    char *out = (char *)malloc((size_t)len + 1);
+    if (!out) return NULL;
+    memcpy(out, s, (size_t)len);
+    out[len] = '\0';
+    return out;
+}
+
+/* Generic "grow array to hold one more element" helper. */
+static int
+rs_grow(void **arr, int *cap, int need, size_t elem)
+{
+    if (need < *cap) return 0;
+    int new_cap = *cap ? *cap * 2 : 16;
+    while (new_cap <= need) new_cap *= 2;
+    void *tmp = realloc(*arr, elem * (size_t)new_cap);
+    if (!tmp) return -1;
+    *arr = tmp;
+    *cap = new_cap;
+    return 0;
+}
+
+static int
+rs_entry_new(RuleSetObject *self, PyObject *rule, int category, int end_only)
+{
+    if (rs_grow((void **)&self->entries, &self->cap_entries,
+                self->n_entries, sizeof(REntry)) < 0)
+        return -1;
+    REntry *e = &self->entries[self->n_entries];
+    Py_INCREF(rule);
+    e->rule = rule;
+    e->category = category;
+    e->end_only = end_only;
+    e->next = -1;
+    return self->n_entries++;
+}
+
+static void
+rs_chain_append(RuleSetObject *self, int *head, int *tail, int idx)
+{
+    if (*head < 0)
+        *head = idx;
+    else
+        self->entries[*tail].next = idx;
+    *tail = idx;
+}
+
+static int
+ac_trie_new_node(KindSet *ks)
+{
+    if (rs_grow((void **)&ks->ac_nodes, &ks->ac_cap, ks->ac_n,
+                sizeof(ACTrieNode)) < 0)
+        return -1;
+    ACTrieNode *nd = &ks->ac_nodes[ks->ac_n];
+    memset(nd->children, 0xff, sizeof(nd->children));
+    nd->fail = 0;
+    nd->out_head = nd->out_tail = -1;
+    nd->dict_suffix = -1;
+    return ks->ac_n++;
+}
+
+static int
+pt_new_node(KindSet *ks)
+{
+    if (rs_grow((void **)&ks->pt_nodes, &ks->pt_cap, ks->pt_n,
+                sizeof(PTrieNode)) < 0)
+        return -1;
+    PTrieNode *nd = &ks->pt_nodes[ks->pt_n];
+    memset(nd->children, 0xff, sizeof(nd->children));
+    nd->head = nd->tail = -1;
+    return ks->pt_n++;
+}
+
+/* ------------------------------------------------------------------ */
+/* Type lifecycle                                                     */
+/* ------------------------------------------------------------------ */
+
+static PyObject *
+RuleSet_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    (void)args; (void)kwds;
+    RuleSetObject *self = (RuleSetObject *)type->tp_alloc(type, 0);
+    if (!self) return NULL;
+    /* tp_alloc zeroes the struct; create both trie roots. */
+    for (int k = 0; k < 2; k++) {
+        if (ac_trie_new_node(&self->kinds[k]) < 0 ||
+            pt_new_node(&self->kinds[k]) < 0) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+    }
+    return (PyObject *)self;
+}
+
+static void
+RuleSet_dealloc(RuleSetObject *self)
+{
+    int mapped = self->map_base != NULL;
+    for (int i = 0; i < self->n_entries; i++)
+        Py_XDECREF(self->entries[i].rule);
+    free(self->entries);
+    for (int k = 0; k < 2; k++) {
+        KindSet *ks = &self->kinds[k];
+        if (!mapped) {
+            for (int i = 0; i < ks->n_ex; i++) free(ks->ex_keys[i]);
+            free(ks->ex_lens);
+            free(ks->ex_heads);
+            free(ks->ex_tails);
+            free(ks->ex_slot);
+            free(ks->delta);
+            free(ks->ac_out);
+            free(ks->ac_dict);
+            free(ks->pt_nodes);
+            for (int i = 0; i < ks->n_gl; i++) {
+                free(ks->gl_progs[i].ops);
+                free(ks->gl_base_progs[i].ops);
+            }
+            free(ks->gl_entries);
+            for (int i = 0; i < ks->n_ap; i++) free(ks->ap_bases[i]);
+            free(ks->ap_lens);
+            free(ks->ap_entries);
+        }
+        /* Pointer containers are heap-allocated in both modes; for a
+         * mapped ruleset the pointees live inside the mapping. */
+        free(ks->ex_keys);
+        free(ks->ac_nodes);
+        free(ks->gl_progs);
+        free(ks->gl_base_progs);
+        free(ks->ap_bases);
+    }
+    if (mapped)
+        munmap(self->map_base, self->map_len);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/* ------------------------------------------------------------------ */
+/* add_* methods (construction, GIL held)                             */
+/* ------------------------------------------------------------------ */
+
+static KindSet *
+rs_check_add(RuleSetObject *self, int kind, int category)
+{
+    if (self->built) {
+        PyErr_SetString(PyExc_RuntimeError, "cannot add rules after build()");
+        return NULL;
+    }
+    if (kind != 0 && kind != 1) {
+        PyErr_SetString(PyExc_ValueError, "kind must be 0 (file) or 1 (dir)");
+        return NULL;
+    }
+    if (category < 0 || category >= RS_MAX_CATEGORIES) {
+        PyErr_Format(PyExc_ValueError, "category must be in [0, %d)",
+                     RS_MAX_CATEGORIES);
+        return NULL;
+    }
+    return &self->kinds[kind];
+}
+
+static PyObject *
+RuleSet_add_exact(RuleSetObject *self, PyObject *args)
+{
+    int kind, category;
+    const char *key;
+    Py_ssize_t key_len;
+    PyObject *rule;
+
+    if (!PyArg_ParseTuple(args, "is#Oi", &kind, &key, &key_len, &rule, &category))
+        return NULL;
+    KindSet *ks = rs_check_add(self, kind, category);
+    if (!ks) return NULL;
+
+    int eid = rs_entry_new(self, rule, category, 0);
+    if (eid < 0) return PyErr_NoMemory();
+
+    /* Linear duplicate scan: rulesets hold dozens of keys, and this
+     * runs once at compile time. */
+    for (int i = 0; i < ks->n_ex; i++) {
+        if (ks->ex_lens[i] == key_len &&
+            memcmp(ks->ex_keys[i], key, (size_t)key_len) == 0) {
+            rs_chain_append(self, &ks->ex_heads[i], &ks->ex_tails[i], eid);
+            Py_RETURN_NONE;
+        }
+    }
+
+    if (ks->n_ex >= ks->cap_ex) {
+        int new_cap = ks->cap_ex ? ks->cap_ex * 2 : 16;
+        char **tk = (char **)realloc(ks->ex_keys, sizeof(char *) * (size_t)new_cap);
+        Py_ssize_t *tl = (Py_ssize_t *)realloc(ks->ex_lens,
+                                               sizeof(Py_ssize_t) * (size_t)new_cap);
+        int *th = (int *)realloc(ks->ex_heads, sizeof(int) * (size_t)new_cap);
+        int *tt = (int *)realloc(ks->ex_tails, sizeof(int) * (size_t)new_cap);
+        if (tk) ks->ex_keys = tk;
+        if (tl) ks->ex_lens = tl;
+        if (th) ks->ex_heads = th;
+        if (tt) ks->ex_tails = tt;
+        if (!tk || !tl || !th || !tt) return PyErr_NoMemory();
+        ks->cap_ex = new_cap;
+    }
+
+    char *copy = rs_strdup(key, key_len);
+    if (!copy) return PyErr_NoMemory();
+    int i = ks->n_ex++;
+    ks->ex_keys[i] = copy;
+    ks->ex_lens[i] = key_len;
+    ks->ex_heads[i] = ks->ex_tails[i] = -1;
+    rs_chain_append(self, &ks->ex_heads[i], &ks->ex_tails[i], eid);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+RuleSet_add_substring(RuleSetObject *self, PyObject *args)
+{
+    int kind, category, end_only;
+    const char *key;
+    Py_ssize_t key_len;
+    PyObject *rule;
+
+    if (!PyArg_ParseTuple(args, "is#Oip", &kind, &key, &key_len, &rule,
+                          &category, &end_only))
+        return NULL;
+    KindSet *ks = rs_check_add(self, kind, category);
+    if (!ks) return NULL;
+
+    int eid = rs_entry_new(self, rule, category, end_only);
+    if (eid < 0) return PyErr_NoMemory();
+
+    int cur = 0;
+    for (Py_ssize_t i = 0; i < key_len; i++) {
+        unsigned char c = (unsigned char)key[i];
+        if (ks->ac_nodes[cur].children[c] < 0) {
+            int nid = ac_trie_new_node(ks);
+            if (nid < 0) return PyErr_NoMemory();
+            ks->ac_nodes[cur].children[c] = nid;
+        }
+        cur = ks->ac_nodes[cur].children[c];
+    }
+    rs_chain_append(self, &ks->ac_nodes[cur].out_head,
+                    &ks->ac_nodes[cur].out_tail, eid);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+RuleSet_add_prefix(RuleSetObject *self, PyObject *args)
+{
+    int kind, category;
+    const char *key;
+    Py_ssize_t key_len;
+    PyObject *rule;
+
+    if (!PyArg_ParseTuple(args, "is#Oi", &kind, &key, &key_len, &rule, &category))
+        return NULL;
+    KindSet *ks = rs_check_add(self, kind, category);
+    if (!ks) return NULL;
+
+    int eid = rs_entry_new(self, rule, category, 0);
+    if (eid < 0) return PyErr_NoMemory();
+
+    int cur = 0;
+    for (Py_ssize_t i = 0; i < key_len; i++) {
+        unsigned char c = (unsigned char)key[i];
+        if (ks->pt_nodes[cur].children[c] < 0) {
+            int nid = pt_new_node(ks);
+            if (nid < 0) return PyErr_NoMemory();
+            ks->pt_nodes[cur].children[c] = nid;
+        }
+        cur = ks->pt_nodes[cur].children[c];
+    }
+    rs_chain_append(self, &ks->pt_nodes[cur].head, &ks->pt_nodes[cur].tail, eid);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+RuleSet_add_glob(RuleSetObject *self, PyObject *args)
+{
+    int kind, category;
+    const char *pat;
+    Py_ssize_t pat_len;
+    PyObject *rule;
+
+    if (!PyArg_ParseTuple(args, "is#Oi", &kind, &pat, &pat_len, &rule, &category))
+        return NULL;
+    KindSet *ks = rs_check_add(self, kind, category);
+    if (!ks) return NULL;
+
+    int eid = rs_entry_new(self, rule, category, 0);
+    if (eid < 0) return PyErr_NoMemory();
+
+    if (ks->n_gl >= ks->cap_gl) {
+        int new_cap = ks->cap_gl ? ks->cap_gl * 2 : 16;
+        GlobProg *tp = (GlobProg *)realloc(ks->gl_progs,
+                                           sizeof(GlobProg) * (size_t)new_cap);
+        GlobProg *tb = (GlobProg *)realloc(ks->gl_base_progs,
+                                           sizeof(GlobProg) * (size_t)new_cap);
+        int *te = (int *)realloc(ks->gl_entries, sizeof(int) * (size_t)new_cap);
+        if (tp) ks->gl_progs = tp;
+        if (tb) ks->gl_base_progs = tb;
+        if (te) ks->gl_entries = te;
+        if (!tp || !tb || !te) return PyErr_NoMemory();
+        ks->cap_gl = new_cap;
+    }
+
+    GlobProg prog = {NULL, 0};
+    GlobProg base_prog = {NULL, 0};
+    if (glob_compile(pat, pat_len, &prog) < 0)
+        return PyErr_NoMemory();
+    if (pat_len > 3 && memcmp(pat + pat_len - 3, "/**", 3) == 0) {
+        if (glob_compile(pat, pat_len - 3, &base_prog) < 0) {
+            free(prog.ops);
+            return PyErr_NoMemory();
+        }
+    }
+    int i = ks->n_gl++;
+    ks->gl_progs[i] = prog;
+    ks->gl_base_progs[i] = base_prog;
+    ks->gl_entries[i] = eid;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+RuleSet_add_path(RuleSetObject *self, PyObject *args)
+{
+    int kind, category;
+    const char *base;
+    Py_ssize_t base_len;
+    PyObject *rule;
+
+    if (!PyArg_ParseTuple(args, "is#Oi", &kind, &base, &base_len, &rule, &category))
+        return NULL;
+    KindSet *ks = rs_check_add(self, kind, category);
+    if (!ks) return NULL;
+
+    int eid = rs_entry_new(self, rule, category, 0);
+    if (eid < 0) return PyErr_NoMemory();
+
+    if (ks->n_ap >= ks->cap_ap) {
+        int new_cap = ks->cap_ap ? ks->cap_ap * 2 : 16;
+        char **tb = (char **)realloc(ks->ap_bases, sizeof(char *) * (size_t)new_cap);
+        Py_ssize_t *tl = (Py_ssize_t *)realloc(ks->ap_lens,
+                                               sizeof(Py_ssize_t) * (size_t)new_cap);
+        int *te = (int *)realloc(ks->ap_entries, sizeof(int) * (size_t)new_cap);
+        if (tb) ks->ap_bases = tb;
+        if (tl) ks->ap_lens = tl;
+        if (te) ks->ap_entries = te;
+        if (!tb || !tl || !te) return PyErr_NoMemory();
+        ks->cap_ap = new_cap;
+    }
+
+    char *copy = rs_strdup(base, base_len);
+    if (!copy) return PyErr_NoMemory();
+    int i = ks->n_ap++;
+    ks->ap_bases[i] = copy;
+    ks->ap_lens[i] = base_len;
+    ks->ap_entries[i] = eid;
+    Py_RETURN_NONE;
+}
+
+/* ------------------------------------------------------------------ */
+/* build() — exact hash + AC fail links + goto-table compaction       */
+/* ------------------------------------------------------------------ */
+
+static int
+kind_build(KindSet *ks)
+{
+    /* Exact hash: open addressing, power-of-two table at <= 50% load. */
+    if (ks->n_ex > 0) {
+        size_t n_slots = 16;
+        while (n_slots < (size_t)ks->n_ex * 2) n_slots *= 2;
+        ks->ex_slot = (int *)malloc(sizeof(int) * n_slots);
+        if (!ks->ex_slot) return -1;
+        for (size_t i = 0; i < n_slots; i++) ks->ex_slot[i] = -1;
+        ks->ex_mask = n_slots - 1;
+        for (int i = 0; i < ks->n_ex; i++) {
+            size_t slot = rs_hash(ks->ex_keys[i], ks->ex_lens[i]) & ks->ex_mask;
+            while (ks->ex_slot[slot] >= 0)
+                slot = (slot + 1) & ks->ex_mask;
+            ks->ex_slot[slot] = i;
+        }
+    }
+
+    /* Aho-Corasick: BFS fail/dict-suffix links, then compact into a
+     * dense goto table over the reduced alphabet and free the trie
+     * (same scheme as csrc/ac_matcher.c, with REntry chains as
+     * outputs). */
+    int n = ks->ac_n;
+    ACTrieNode *nodes = ks->ac_nodes;
+
+    int *queue = (int *)malloc(sizeof(int) * (size_t)n);
+    if (!queue) return -1;
+    int head = 0, tail = 0;
+
+    for (int c = 0; c < RS_ALPHA; c++) {
+        int child = nodes[0].children[c];
+        if (child > 0) {
+            nodes[child].fail = 0;
+            nodes[child].dict_suffix = -1;
+            queue[tail++] = child;
+        }
+    }
+    while (head < tail) {
+        int u = queue[head++];
+        for (int c = 0; c < RS_ALPHA; c++) {
+            int v = nodes[u].children[c];
+            if (v < 0) continue;
+            int f = nodes[u].fail;
+            while (f > 0 && nodes[f].children[c] < 0)
+                f = nodes[f].fail;
+            if (nodes[f].children[c] >= 0 && nodes[f].children[c] != v)
+                f = nodes[f].children[c];
+            nodes[v].fail = f;
+            if (nodes[f].out_head >= 0)
+                nodes[v].dict_suffix = f;
+            else
+                nodes[v].dict_suffix = nodes[f].dict_suffix;
+            queue[tail++] = v;
+        }
+    }
+
+    memset(ks->charmap, 0, sizeof(ks->charmap));
+    int n_classes = 1;
+    for (int u = 0; u < n; u++) {
+        for (int c = 0; c < RS_ALPHA; c++) {
+            if (nodes[u].children[c] >= 0 && ks->charmap[c] == 0)
+                ks->charmap[c] = (unsigned char)n_classes++;
+        }
+    }
+    ks->n_classes = n_classes;
+
+    int *delta = (int *)malloc(sizeof(int) * (size_t)n * (size_t)n_classes);
+    int *out = (int *)malloc(sizeof(int) * (size_t)n);
+    int *dict = (int *)malloc(sizeof(int) * (size_t)n);
+    if (!delta || !out || !dict) {
+        free(delta);
+        free(out);
+        free(dict);
+        free(queue);
+        return -1;
+    }
+    for (int u = 0; u < n; u++) {
+        out[u] = nodes[u].out_head;
+        dict[u] = nodes[u].dict_suffix;
+        delta[u * n_classes] = 0;
+    }
+    for (int c = 0; c < RS_ALPHA; c++) {
+        int k = ks->charmap[c];
+        if (k == 0) continue;
+        int child = nodes[0].children[c];
+        delta[k] = (child > 0) ? child : 0;
+    }
+    for (int qi = 0; qi < tail; qi++) {
+        int u = queue[qi];
+        for (int c = 0; c < RS_ALPHA; c++) {
+            int k = ks->charmap[c];
+            if (k == 0) continue;
+            int v = nodes[u].children[c];
+            delta[u * n_classes + k] =
+                (v >= 0) ? v : delta[nodes[u].fail * n_classes + k];
+        }
+    }
+
+    ks->delta = delta;
+    ks->ac_out = out;
+    ks->ac_dict = dict;
+    free(ks->ac_nodes);
+    ks->ac_nodes = NULL;
+    ks->ac_cap = 0;
+    free(queue);
+    return 0;
+}
+
+static PyObject *
+RuleSet_build(RuleSetObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (self->built) {
+        PyErr_SetString(PyExc_RuntimeError, "ruleset already built");
+        return NULL;
+    }
+    for (int k = 0; k < 2; k++) {
+        if (kind_build(&self->kinds[k]) < 0)
+            return PyErr_NoMemory();
+    }
+    self->built = 1;
+    Py_RETURN_NONE;
+}
+
+/* ------------------------------------------------------------------ */
+/* Matching (pure C; callable with the GIL released)                  */
+/* ------------------------------------------------------------------ */
+
+/* Walk one entry chain, appending rules whose category has not fired
+ * yet.  hits[] needs at most RS_MAX_CATEGORIES slots. */
+static void
+chain_collect(const RuleSetObject *self, int head, Py_ssize_t end_idx,
+              Py_ssize_t last_idx, uint64_t *seen, int *hits, int *n_hits)
+{
+    for (int e = head; e >= 0; e = self->entries[e].next) {
+        const REntry *ent = &self->entries[e];
+        if (ent->end_only && end_idx != last_idx)
+            continue;
+        uint64_t bit = (uint64_t)1 << ent->category;
+        if (*seen & bit)
+            continue;
+        *seen |= bit;
+        hits[(*n_hits)++] = e;
+    }
+}
+
+static int
+glob_match(const GlobProg *prog, const GlobProg *base_prog,
+           const char *path, Py_ssize_t plen,
+           const char *base, Py_ssize_t blen)
+{
+    if (base_prog->ops && glob_run(base_prog, path, plen))
+        return 1;
+    if (glob_run(prog, path, plen))
+        return 1;
+    return glob_run(prog, base, blen);
+}
+
+/* Run every tier for one node.  Returns the number of winning entries
+ * written to hits[] (bounded by RS_MAX_CATEGORIES). */
+static int
+kind_match(const RuleSetObject *self, const KindSet *ks,
+           const char *path, Py_ssize_t plen,
+           const char *base, Py_ssize_t blen, int *hits)
+{
+    uint64_t seen = 0;
+    int n_hits = 0;
+    Py_ssize_t last = plen - 1;
+
+    /* --- EXACT: hash lookup on basename --- */
+    if (ks->ex_slot) {
+        size_t slot = rs_hash(base, blen) & ks->ex_mask;
+        while (ks->ex_slot[slot] >= 0) {
+            int i = ks->ex_slot[slot];
+            if (ks->ex_lens[i] == blen &&
+                memcmp(ks->ex_keys[i], base, (size_t)blen) == 0) {
+                chain_collect(self, ks->ex_heads[i], -1, -1, &seen,
+                              hits, &n_hits);
+                break;
+            }
+            slot = (slot + 1) & ks->ex_mask;
+        }
+    }
+
+    /* --- CONTAINS + ENDSWITH: Aho-Corasick over the path --- */
+    if (ks->ac_n > 1) {
+        const int *delta = ks->delta;
+        const int *out = ks->ac_out;
+        const int *dict = ks->ac_dict;
+        const unsigned char *charmap = ks->charmap;
+        const int n_classes = ks->n_classes;
+        int state = 0;
+        for (Py_ssize_t i = 0; i < plen; i++) {
+            state = delta[state * n_classes + charmap[(unsigned char)path[i]]];
+            int tmp = state;
+            while (tmp > 0) {
+                if (out[tmp] >= 0)
+                    chain_collect(self, out[tmp], i, last, &seen,
+                                  hits, &n_hits);
+                tmp = dict[tmp];
+            }
+        }
+    }
+
+    /* --- STARTSWITH: prefix trie walk on basename --- */
+    if (ks->pt_n > 1) {
+        int cur = 0;
+        for (Py_ssize_t i = 0; i < blen; i++) {
+            cur = ks->pt_nodes[cur].children[(unsigned char)base[i]];
+            if (cur < 0) break;
+            if (ks->pt_nodes[cur].head >= 0)
+                chain_collect(self, ks->pt_nodes[cur].head, -1, -1, &seen,
+                              hits, &n_hits);
+        }
+    }
+
+    /* --- GLOB fallback (compiled programs) --- */
+    for (int i = 0; i < ks->n_gl; i++) {
+        if (glob_match(&ks->gl_progs[i], &ks->gl_base_progs[i],
+                       path, plen, base, blen))
+            chain_collect(self, ks->gl_entries[i], -1, -1, &seen,
+                          hits, &n_hits);
+    }
+
+    /* --- Additional paths: base itself or anything under base/ --- */
+    for (int i = 0; i < ks->n_ap; i++) {
+        Py_ssize_t bl = ks->ap_lens[i];
+        if ((plen == bl && memcmp(path, ks->ap_bases[i], (size_t)bl) == 0) ||
+            (plen > bl && path[bl] == '/' &&
+             memcmp(path, ks->ap_bases[i], (size_t)bl) == 0))
+            chain_collect(self, ks->ap_entries[i], -1, -1, &seen,
+                          hits, &n_hits);
+    }
+
+    return n_hits;
+}
+
+static PyObject *
+hits_to_list(const RuleSetObject *self, const int *hits, int n_hits)
+{
+    PyObject *result = PyList_New(n_hits);
+    if (!result) return NULL;
+    for (int i = 0; i < n_hits; i++) {
+        PyObject *rule = self->entries[hits[i]].rule;
+        Py_INCREF(rule);
+        PyList_SET_ITEM(result, i, rule);
+    }
+    return result;
+}
+
+static PyObject *
+RuleSet_match(RuleSetObject *self, PyObject *args)
+{
+    const char *path, *base;
+    Py_ssize_t plen, blen;
+    int is_dir;
+
+    if (!PyArg_ParseTuple(args, "s#s#p", &path, &plen, &base, &blen, &is_dir))
+        return NULL;
+    if (!self->built) {
+        PyErr_SetString(PyExc_RuntimeError, "call build() before match()");
+        return NULL;
+    }
+
+    int hits[RS_MAX_CATEGORIES];
+    int n_hits = kind_match(self, &self->kinds[is_dir ? 1 : 0],
+                            path, plen, base, blen, hits);
+    return hits_to_list(self, hits, n_hits);
+}
+
+/* One recorded winner during the GIL-free batch phase. */
+typedef struct {
+    Py_ssize_t item;
+    int entry;
+} RSHit;
+
+static PyObject *
+RuleSet_match_many(RuleSetObject *self, PyObject *args)
+{
+    PyObject *items;
+
+    if (!PyArg_ParseTuple(args, "O!", &PyList_Type, &items))
+        return NULL;
+    if (!self->built) {
+        PyErr_SetString(PyExc_RuntimeError, "call build() before match_many()");
+        return NULL;
+    }
+
+    Py_ssize_t n_items = PyList_GET_SIZE(items);
+    PyObject *result = PyList_New(n_items);
+    if (!result) return NULL;
+    if (n_items == 0) return result;
+
+    /* Phase 1 (GIL held): pin UTF-8 buffers and dir flags.  The list
+     * keeps the strings alive through the scan. */
+    const char **paths = (const char **)malloc(sizeof(char *) * (size_t)n_items);
+    const char **bases = (const char **)malloc(sizeof(char *) * (size_t)n_items);
+    Py_ssize_t *plens = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * (size_t)n_items);
+    Py_ssize_t *blens = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * (size_t)n_items);
+    char *dirs = (char *)malloc((size_t)n_items);
+    RSHit *rhits = NULL;
+    if (!paths || !bases || !plens || !blens || !dirs) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    for (Py_ssize_t i = 0; i < n_items; i++) {
+        PyObject *item = PyList_GET_ITEM(items, i);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 3) {
+            PyErr_SetString(PyExc_TypeError,
+                            "items must be (path, basename, is_dir) tuples");
+            goto fail;
+        }
+        paths[i] = PyUnicode_AsUTF8AndSize(PyTuple_GET_ITEM(item, 0), &plens[i]);
+        bases[i] = PyUnicode_AsUTF8AndSize(PyTuple_GET_ITEM(item, 1), &blens[i]);
+        if (!paths[i] || !bases[i])
+            goto fail;
+        int d = PyObject_IsTrue(PyTuple_GET_ITEM(item, 2));
+        if (d < 0)
+            goto fail;
+        dirs[i] = (char)d;
+    }
+
+    /* Phase 2 (GIL released): every tier is plain C, including the
+     * exact hash and the compiled glob programs, so the whole batch
+     * runs without touching the interpreter. */
+    size_t n_rhits = 0, cap_rhits = 0;
+    int oom = 0;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < n_items && !oom; i++) {
+        int hits[RS_MAX_CATEGORIES];
+        int n_hits = kind_match(self, &self->kinds[dirs[i] ? 1 : 0],
+                                paths[i], plens[i], bases[i], blens[i], hits);
+        if (n_hits == 0) continue;
+        if (n_rhits + (size_t)n_hits > cap_rhits) {
+            size_t new_cap = cap_rhits ? cap_rhits * 2 : 64;
+            while (new_cap < n_rhits + (size_t)n_hits) new_cap *= 2;
+            RSHit *tmp = (RSHit *)realloc(rhits, sizeof(RSHit) * new_cap);
+            if (!tmp) {
+                oom = 1;
+                break;
+            }
+            rhits = tmp;
+            cap_rhits = new_cap;
+        }
+        for (int h = 0; h < n_hits; h++) {
+            rhits[n_rhits].item = i;
+            rhits[n_rhits].entry = hits[h];
+            n_rhits++;
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    if (oom) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    /* Phase 3 (GIL held): one rule list per item, empty lists for the
+     * zero-match majority. */
+    {
+        size_t h = 0;
+        for (Py_ssize_t i = 0; i < n_items; i++) {
+            int count = 0;
+            while (h + (size_t)count < n_rhits &&
+                   rhits[h + (size_t)count].item == i)
+                count++;
+            PyObject *inner = PyList_New(count);
+            if (!inner)
+                goto fail;
+            for (int j = 0; j < count; j++) {
+                PyObject *rule = self->entries[rhits[h + (size_t)j].entry].rule;
+                Py_INCREF(rule);
+                PyList_SET_ITEM(inner, j, rule);
+            }
+            h += (size_t)count;
+            PyList_SET_ITEM(result, i, inner);
+        }
+    }
+
+    free(paths);
+    free(bases);
+    free(plens);
+    free(blens);
+    free(dirs);
+    free(rhits);
+    return result;
+
+fail:
+    free(paths);
+    free(bases);
+    free(plens);
+    free(blens);
+    free(dirs);
+    free(rhits);
+    Py_DECREF(result);
+    return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Binary cache format                                                */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Persisted warm-start cache: save() dumps the *built* matcher arrays
+ * (the compacted AC goto table, the prefix trie, the exact hash, the
+ * compiled glob programs and the additional-path bases) so a later
+ * load() skips brace expansion, trie insertion and the whole BFS /
+ * goto-table compaction on startup.
+ *
+ * Layout (native integers, 8-byte-padded sections — a same-machine
+ * cache, not an interchange format, same stance as csrc/scan_tree.c):
+ *
+ *   RSCHeader                          (32 bytes, magic "DUXRSET1")
+ *   entry category / end_only / next   (n_entries x int32 each)
+ *   2 x kind section (file, dir):
+ *     RSCKindHeader                    (96 bytes)
+ *     ex_lens                          (n_ex x int64)
+ *     ex_heads / ex_tails              (n_ex x int32 each)
+ *     ex_slot                          (ex_slots x int32)
+ *     exact keys                       (NUL-terminated, packed)
+ *     charmap                          (256 bytes)
+ *     delta                            (ac_n * n_classes x int32)
+ *     ac_out / ac_dict                 (ac_n x int32 each)
+ *     pt_nodes                         (pt_n x sizeof(PTrieNode))
+ *     gl_nops / gl_base_nops / gl_entries  (n_gl x int32 each)
+ *     glob ops / base ops              (raw GlobOp runs, packed)
+ *     ap_lens                          (n_ap x int64)
+ *     ap_entries                       (n_ap x int32)
+ *     additional-path bases            (NUL-terminated, packed)
+ *
+ * Rule objects are Python values and never hit the file: load() takes
+ * the rules in registration order (one per REntry, the same order the
+ * add_* calls produced them) and re-attaches them by index.  The
+ * caller keys the file on a hash of that registration stream, so a
+ * config change simply misses the cache.
+ *
+ * load() maps the file MAP_PRIVATE read-only and points the big arrays
+ * (delta, pt_nodes, ex_slot, ...) straight into the mapping; only the
+ * small pointer containers (ex_keys, GlobProg, ap_bases) are rebuilt,
+ * each pointing at bytes inside the map.
+ */
+
+#define RSC_MAGIC "DUXRSET1"
+
+static PyTypeObject RuleSetType;  /* load() allocates before the definition */
+
+typedef struct {
+    char magic[8];
+    int64_t n_entries;
+    int64_t reserved[2];  /* zero; keeps the header at 32 bytes */
+} RSCHeader;
+
+typedef struct {
+    int64_t n_ex;
+    int64_t ex_slots;          /* hash-table size, 0 when no exact keys */
+    int64_t ex_key_bytes;      /* packed NUL-terminated keys */
+    int64_t ac_n;
+    int64_t n_classes;
+    int64_t pt_n;
+    int64_t n_gl;
+    int64_t gl_op_bytes;       /* packed GlobOp runs, main programs */
+    int64_t gl_base_op_bytes;  /* packed GlobOp runs, base programs */
+    int64_t n_ap;
+    int64_t ap_base_bytes;     /* packed NUL-terminated bases */
+    int64_t reserved;          /* zero; keeps the header at 96 bytes */
+} RSCKindHeader;
+
+_Static_assert(sizeof(RSCHeader) == 32, "cache header must be 32 bytes");
+_Static_assert(sizeof(RSCKindHeader) == 96, "kind header must be 96 bytes");
+_Static_assert(sizeof(int) == sizeof(int32_t),
+               "cache format assumes 32-bit int");
+_Static_assert(sizeof(Py_ssize_t) == sizeof(int64_t),
+               "cache format requires 64-bit Py_ssize_t");
+
+static size_t
+rsc_pad8(size_t n)
+{
+    return (n + 7) & ~(size_t)7;
+}
+
+/* write() until done; returns 0 or -1 with errno set. */
+static int
+rsc_write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* Zeros up to the next 8-byte boundary after *total* payload bytes. */
+static int
+rsc_write_padding(int fd, size_t total)
+{
+    static const char zeros[8] = {0};
+    size_t pad = rsc_pad8(total) - total;
+    return pad > 0 ? rsc_write_all(fd, zeros, pad) : 0;
+}
+
+/* One padded section: the payload followed by zeros up to an 8-byte
+ * boundary, so every mapped section stays naturally aligned. */
+static int
+rsc_write_sect(int fd, const void *buf, size_t len)
+{
+    if (len > 0 && rsc_write_all(fd, buf, len) < 0)
+        return -1;
+    return rsc_write_padding(fd, len);
+}
+
+static int
+rsc_write_kind(const KindSet *ks, int fd)
+{
+    size_t key_bytes = 0, ap_bytes = 0, op_bytes = 0, base_op_bytes = 0;
+    for (int i = 0; i < ks->n_ex; i++)
+        key_bytes += (size_t)ks->ex_lens[i] + 1;
+    for (int i = 0; i < ks->n_gl; i++) {
+        op_bytes += (size_t)ks->gl_progs[i].n_ops * sizeof(GlobOp);
+        base_op_bytes += (size_t)ks->gl_base_progs[i].n_ops * sizeof(GlobOp);
+    }
+    for (int i = 0; i < ks->n_ap; i++)
+        ap_bytes += (size_t)ks->ap_lens[i] + 1;
+
+    RSCKindHeader kh;
+    memset(&kh, 0, sizeof(kh));
+    kh.n_ex = ks->n_ex;
+    kh.ex_slots = ks->ex_slot ? (int64_t)(ks->ex_mask + 1) : 0;
+    kh.ex_key_bytes = (int64_t)key_bytes;
+    kh.ac_n = ks->ac_n;
+    kh.n_classes = ks->n_classes;
+    kh.pt_n = ks->pt_n;
+    kh.n_gl = ks->n_gl;
+    kh.gl_op_bytes = (int64_t)op_bytes;
+    kh.gl_base_op_bytes = (int64_t)base_op_bytes;
+    kh.n_ap = ks->n_ap;
+    kh.ap_base_bytes = (int64_t)ap_bytes;
+
+    size_t n_ex = (size_t)ks->n_ex, n_gl = (size_t)ks->n_gl;
+    size_t n_ap = (size_t)ks->n_ap;
+
+    if (rsc_write_all(fd, &kh, sizeof(kh)) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ex_lens, n_ex * 8) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ex_heads, n_ex * 4) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ex_tails, n_ex * 4) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ex_slot, (size_t)kh.ex_slots * 4) < 0) return -1;
+    for (int i = 0; i < ks->n_ex; i++) {
+        if (rsc_write_all(fd, ks->ex_keys[i], (size_t)ks->ex_lens[i] + 1) < 0)
+            return -1;
+    }
+    if (rsc_write_padding(fd, key_bytes) < 0) return -1;
+    if (rsc_write_all(fd, ks->charmap, RS_ALPHA) < 0) return -1;
+    if (rsc_write_sect(fd, ks->delta,
+                       (size_t)ks->ac_n * (size_t)ks->n_classes * 4) < 0)
+        return -1;
+    if (rsc_write_sect(fd, ks->ac_out, (size_t)ks->ac_n * 4) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ac_dict, (size_t)ks->ac_n * 4) < 0) return -1;
+    if (rsc_write_sect(fd, ks->pt_nodes,
+                       (size_t)ks->pt_n * sizeof(PTrieNode)) < 0)
+        return -1;
+
+    if (n_gl > 0) {
+        /* n_ops lives inside GlobProg; gather into contiguous arrays.
+         * A NULL base program (no trailing slash-star-star) is encoded
+         * as -1 to keep it distinct from a zero-op program. */
+        int *tmp = (int *)malloc(sizeof(int) * n_gl);
+        if (!tmp) return -1;
+        for (size_t i = 0; i < n_gl; i++)
+            tmp[i] = ks->gl_progs[i].n_ops;
+        int rc = rsc_write_sect(fd, tmp, n_gl * 4);
+        if (rc == 0) {
+            for (size_t i = 0; i < n_gl; i++)
+                tmp[i] = ks->gl_base_progs[i].ops
+                    ? ks->gl_base_progs[i].n_ops : -1;
+            rc = rsc_write_sect(fd, tmp, n_gl * 4);
+        }
+        free(tmp);
+        if (rc < 0) return -1;
+        if (rsc_write_sect(fd, ks->gl_entries, n_gl * 4) < 0) return -1;
+        for (size_t i = 0; i < n_gl; i++) {
+            if (ks->gl_progs[i].n_ops > 0 &&
+                rsc_write_all(fd, ks->gl_progs[i].ops,
+                              (size_t)ks->gl_progs[i].n_ops
+                              * sizeof(GlobOp)) < 0)
+                return -1;
+        }
+        if (rsc_write_padding(fd, op_bytes) < 0) return -1;
+        for (size_t i = 0; i < n_gl; i++) {
+            if (ks->gl_base_progs[i].ops && ks->gl_base_progs[i].n_ops > 0 &&
+                rsc_write_all(fd, ks->gl_base_progs[i].ops,
+                              (size_t)ks->gl_base_progs[i].n_ops
+                              * sizeof(GlobOp)) < 0)
+                return -1;
+        }
+        if (rsc_write_padding(fd, base_op_bytes) < 0) return -1;
+    }
+
+    if (rsc_write_sect(fd, ks->ap_lens, n_ap * 8) < 0) return -1;
+    if (rsc_write_sect(fd, ks->ap_entries, n_ap * 4) < 0) return -1;
+    for (int i = 0; i < ks->n_ap; i++) {
+        if (rsc_write_all(fd, ks->ap_bases[i], (size_t)ks->ap_lens[i] + 1) < 0)
+            return -1;
+    }
+    return rsc_write_padding(fd, ap_bytes);
+}
+
+static int
+rsc_write(const RuleSetObject *self, int fd)
+{
+    size_t n = (size_t)self->n_entries;
+
+    RSCHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, RSC_MAGIC, 8);
+    hdr.n_entries = self->n_entries;
+    if (rsc_write_all(fd, &hdr, sizeof(hdr)) < 0) return -1;
+
+    if (n > 0) {
+        int *tmp = (int *)malloc(sizeof(int) * n);
+        if (!tmp) return -1;
+        int rc = 0;
+        for (size_t i = 0; rc == 0 && i < 3; i++) {
+            for (size_t j = 0; j < n; j++) {
+                const REntry *e = &self->entries[j];
+                tmp[j] = (i == 0) ? e->category
+                       : (i == 1) ? e->end_only : e->next;
+            }
+            rc = rsc_write_sect(fd, tmp, n * 4);
+        }
+        free(tmp);
+        if (rc < 0) return -1;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        if (rsc_write_kind(&self->kinds[k], fd) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+RuleSet_save(RuleSetObject *self, PyObject *args)
+{
+    PyObject *path_obj;
+    if (!PyArg_ParseTuple(args, "U", &path_obj))
+        return NULL;
+    if (!self->built) {
+        PyErr_SetString(PyExc_RuntimeError, "call build() before save()");
+        return NULL;
+    }
+
+    const char *path = PyUnicode_AsUTF8(path_obj);
+    if (!path) return NULL;
+
+    int fd, rc;
+    Py_BEGIN_ALLOW_THREADS
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    rc = (fd < 0) ? -1 : rsc_write(self, fd);
+    if (fd >= 0 && close(fd) < 0)
+        rc = -1;
+    Py_END_ALLOW_THREADS
+
+    if (rc < 0)
+        return PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+    Py_RETURN_NONE;
+}
+
+/* Consume one padded section from the mapping; NULL when it would run
+ * past the end.  A zero-length section is valid and consumes nothing. */
+static const char *
+rsc_take(const char **p, size_t *left, size_t len)
+{
+    size_t padded = rsc_pad8(len);
+    if (padded > *left)
+        return NULL;
+    const char *out = *p;
+    *p += padded;
+    *left -= padded;
+    return out;
+}
+
+/* Rebuild one KindSet from the mapping.  Returns 0, -1 on a malformed
+ * file, or -2 on allocation failure.  Partially-filled fields are safe:
+ * dealloc skips mapped pointees and free()s only the containers. */
+static int
+rsc_load_kind(KindSet *ks, const char **p, size_t *left)
+{
+    const RSCKindHeader *kh =
+        (const RSCKindHeader *)rsc_take(p, left, sizeof(RSCKindHeader));
+    if (!kh) return -1;
+    if (kh->n_ex < 0 || kh->n_ex > INT_MAX ||
+        kh->ex_slots < 0 || kh->ex_slots > INT_MAX ||
+        kh->ex_key_bytes < 0 ||
+        kh->ac_n < 1 || kh->ac_n > INT_MAX ||
+        kh->n_classes < 1 || kh->n_classes > RS_ALPHA + 1 ||
+        kh->pt_n < 1 || kh->pt_n > INT_MAX ||
+        kh->n_gl < 0 || kh->n_gl > INT_MAX ||
+        kh->gl_op_bytes < 0 || kh->gl_base_op_bytes < 0 ||
+        kh->n_ap < 0 || kh->n_ap > INT_MAX || kh->ap_base_bytes < 0)
+        return -1;
+
+    size_t n_ex = (size_t)kh->n_ex, n_gl = (size_t)kh->n_gl;
+    size_t n_ap = (size_t)kh->n_ap;
+    size_t key_bytes = (size_t)kh->ex_key_bytes;
+    size_t ap_bytes = (size_t)kh->ap_base_bytes;
+
+    const char *ex_lens = rsc_take(p, left, n_ex * 8);
+    const char *ex_heads = rsc_take(p, left, n_ex * 4);
+    const char *ex_tails = rsc_take(p, left, n_ex * 4);
+    const char *ex_slot = rsc_take(p, left, (size_t)kh->ex_slots * 4);
+    const char *keys = rsc_take(p, left, key_bytes);
+    const char *charmap = rsc_take(p, left, RS_ALPHA);
+    const char *delta = rsc_take(p, left,
+                                 (size_t)kh->ac_n * (size_t)kh->n_classes * 4);
+    const char *ac_out = rsc_take(p, left, (size_t)kh->ac_n * 4);
+    const char *ac_dict = rsc_take(p, left, (size_t)kh->ac_n * 4);
+    const char *pt_nodes = rsc_take(p, left,
+                                    (size_t)kh->pt_n * sizeof(PTrieNode));
+    if (!ex_lens || !ex_heads || !ex_tails || !ex_slot || !keys ||
+        !charmap || !delta || !ac_out || !ac_dict || !pt_nodes)
+        return -1;
+
+    ks->n_ex = (int)n_ex;
+    ks->cap_ex = (int)n_ex;
+    ks->ex_lens = (Py_ssize_t *)ex_lens;
+    ks->ex_heads = (int *)ex_heads;
+    ks->ex_tails = (int *)ex_tails;
+    ks->ex_slot = kh->ex_slots ? (int *)ex_slot : NULL;
+    ks->ex_mask = kh->ex_slots ? (size_t)kh->ex_slots - 1 : 0;
+    if (n_ex > 0) {
+        ks->ex_keys = (char **)malloc(sizeof(char *) * n_ex);
+        if (!ks->ex_keys) return -2;
+        size_t off = 0;
+        for (size_t i = 0; i < n_ex; i++) {
+            Py_ssize_t klen = ks->ex_lens[i];
+            if (klen < 0 || off + (size_t)klen + 1 > key_bytes ||
+                keys[off + (size_t)klen] != '\0')
+                return -1;
+            ks->ex_keys[i] = (char *)keys + off;
+            off += (size_t)klen + 1;
+        }
+        if (off != key_bytes) return -1;
+    }
+
+    memcpy(ks->charmap, charmap, RS_ALPHA);
+    ks->n_classes = (int)kh->n_classes;
+    ks->ac_n = (int)kh->ac_n;
+    ks->delta = (int *)delta;
+    ks->ac_out = (int *)ac_out;
+    ks->ac_dict = (int *)ac_dict;
+
+    ks->pt_n = (int)kh->pt_n;
+    ks->pt_cap = (int)kh->pt_n;
+    ks->pt_nodes = (PTrieNode *)pt_nodes;
+
+    if (n_gl > 0) {
+        const char *nops = rsc_take(p, left, n_gl * 4);
+        const char *base_nops = rsc_take(p, left, n_gl * 4);
+        const char *entries = rsc_take(p, left, n_gl * 4);
+        const char *ops = rsc_take(p, left, (size_t)kh->gl_op_bytes);
+        const char *base_ops = rsc_take(p, left, (size_t)kh->gl_base_op_bytes);
+        if (!nops || !base_nops || !entries || !ops || !base_ops)
+            return -1;
+        ks->gl_progs = (GlobProg *)malloc(sizeof(GlobProg) * n_gl);
+        ks->gl_base_progs = (GlobProg *)malloc(sizeof(GlobProg) * n_gl);
+        if (!ks->gl_progs || !ks->gl_base_progs) return -2;
+        ks->n_gl = (int)n_gl;
+        ks->cap_gl = (int)n_gl;
+        ks->gl_entries = (int *)entries;
+        size_t off = 0, base_off = 0;
+        for (size_t i = 0; i < n_gl; i++) {
+            int no = ((const int *)nops)[i];
+            int bo = ((const int *)base_nops)[i];
+            if (no < 0 ||
+                off + (size_t)no * sizeof(GlobOp) > (size_t)kh->gl_op_bytes)
+                return -1;
+            ks->gl_progs[i].ops = no > 0 ? (GlobOp *)(ops + off) : NULL;
+            ks->gl_progs[i].n_ops = no;
+            off += (size_t)no * sizeof(GlobOp);
+            if (bo < 0) {
+                /* -1 sentinel: no base program for this pattern. */
+                ks->gl_base_progs[i].ops = NULL;
+                ks->gl_base_progs[i].n_ops = 0;
+                continue;
+            }
+            if (base_off + (size_t)bo * sizeof(GlobOp)
+                > (size_t)kh->gl_base_op_bytes)
+                return -1;
+            ks->gl_base_progs[i].ops = (GlobOp *)(base_ops + base_off);
+            ks->gl_base_progs[i].n_ops = bo;
+            base_off += (size_t)bo * sizeof(GlobOp);
+        }
+        if (off != (size_t)kh->gl_op_bytes ||
+            base_off != (size_t)kh->gl_base_op_bytes)
+            return -1;
+    }
+    else if (kh->gl_op_bytes != 0 || kh->gl_base_op_bytes != 0) {
+        return -1;
+    }
+
+    const char *ap_lens = rsc_take(p, left, n_ap * 8);
+    const char *ap_entries = rsc_take(p, left, n_ap * 4);
+    const char *bases = rsc_take(p, left, ap_bytes);
+    if (!ap_lens || !ap_entries || !bases)
+        return -1;
+    ks->ap_lens = (Py_ssize_t *)ap_lens;
+    ks->ap_entries = (int *)ap_entries;
+    if (n_ap > 0) {
+        ks->ap_bases = (char **)malloc(sizeof(char *) * n_ap);
+        if (!ks->ap_bases) return -2;
+        size_t off = 0;
+        for (size_t i = 0; i < n_ap; i++) {
+            Py_ssize_t blen = ks->ap_lens[i];
+            if (blen < 0 || off + (size_t)blen + 1 > ap_bytes ||
+                bases[off + (size_t)blen] != '\0')
+                return -1;
+            ks->ap_bases[i] = (char *)bases + off;
+            off += (size_t)blen + 1;
+        }
+        if (off != ap_bytes) return -1;
+    }
+    else if (ap_bytes != 0) {
+        return -1;
+    }
+    ks->n_ap = (int)n_ap;
+    ks->cap_ap = (int)n_ap;
+    return 0;
+}
+
+static PyObject *
+RuleSet_load(PyObject *cls, PyObject *args)
+{
+    (void)cls;
+    PyObject *path_obj, *rules_obj;
+    if (!PyArg_ParseTuple(args, "UO", &path_obj, &rules_obj))
+        return NULL;
+
+    const char *path = PyUnicode_AsUTF8(path_obj);
+    if (!path) return NULL;
+    PyObject *rules = PySequence_Fast(rules_obj, "rules must be a sequence");
+    if (!rules) return NULL;
+
+    void *base = MAP_FAILED;
+    size_t map_len = 0;
+    Py_BEGIN_ALLOW_THREADS
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            if (st.st_size >= (off_t)sizeof(RSCHeader)) {
+                map_len = (size_t)st.st_size;
+                /* Read-only: a built ruleset is immutable, so unlike
+                 * the scan-tree snapshot no page is ever dirtied. */
+                base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+            } else {
+                errno = EINVAL;
+            }
+        }
+        close(fd);
+    }
+    Py_END_ALLOW_THREADS
+
+    if (base == MAP_FAILED) {
+        Py_DECREF(rules);
+        return PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+    }
+
+    const RSCHeader *hdr = (const RSCHeader *)base;
+    if (memcmp(hdr->magic, RSC_MAGIC, 8) != 0 ||
+        hdr->n_entries < 0 || hdr->n_entries > INT_MAX)
+        goto bad_format;
+    size_t n = (size_t)hdr->n_entries;
+    if (PySequence_Fast_GET_SIZE(rules) != (Py_ssize_t)n) {
+        munmap(base, map_len);
+        Py_DECREF(rules);
+        PyErr_Format(PyExc_ValueError,
+                     "rule count mismatch: cache has %zd entries, got %zd rules",
+                     (Py_ssize_t)n, PySequence_Fast_GET_SIZE(rules));
+        return NULL;
+    }
+
+    const char *p = (const char *)base + sizeof(RSCHeader);
+    size_t left = map_len - sizeof(RSCHeader);
+    const char *cats = rsc_take(&p, &left, n * 4);
+    const char *ends = rsc_take(&p, &left, n * 4);
+    const char *nexts = rsc_take(&p, &left, n * 4);
+    if (!cats || !ends || !nexts)
+        goto bad_format;
+
+    RuleSetObject *self = (RuleSetObject *)
+        RuleSetType.tp_alloc(&RuleSetType, 0);
+    if (!self) {
+        munmap(base, map_len);
+        Py_DECREF(rules);
+        return NULL;
+    }
+    /* From here dealloc owns the mapping and skips mapped pointees. */
+    self->map_base = base;
+    self->map_len = map_len;
+
+    if (n > 0) {
+        self->entries = (REntry *)malloc(sizeof(REntry) * n);
+        if (!self->entries) {
+            Py_DECREF(self);
+            Py_DECREF(rules);
+            return PyErr_NoMemory();
+        }
+        self->cap_entries = (int)n;
+        for (size_t i = 0; i < n; i++) {
+            REntry *e = &self->entries[i];
+            e->rule = Py_NewRef(PySequence_Fast_GET_ITEM(rules, i));
+            e->category = ((const int *)cats)[i];
+            e->end_only = ((const int *)ends)[i];
+            e->next = ((const int *)nexts)[i];
+        }
+        self->n_entries = (int)n;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        int rc = rsc_load_kind(&self->kinds[k], &p, &left);
+        if (rc == -2) {
+            Py_DECREF(self);
+            Py_DECREF(rules);
+            return PyErr_NoMemory();
+        }
+        if (rc < 0) {
+            Py_DECREF(self);
+            goto bad_format_nomap;
+        }
+    }
+    if (left != 0) {
+        Py_DECREF(self);
+        goto bad_format_nomap;
+    }
+
+    self->built = 1;
+    Py_DECREF(rules);
+    return (PyObject *)self;
+
+bad_format:
+    munmap(base, map_len);
+bad_format_nomap:
+    Py_DECREF(rules);
+    PyErr_Format(PyExc_ValueError,
+                 "not a dux ruleset cache (bad magic or truncated): %U",
+                 path_obj);
+    return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Type definition                                                    */
+/* ------------------------------------------------------------------ */
+
+static PyMethodDef RuleSet_methods[] = {
+    {"add_exact", (PyCFunction)RuleSet_add_exact, METH_VARARGS,
+     "add_exact(kind, key, rule, category) — exact basename match"},
+    {"add_substring", (PyCFunction)RuleSet_add_substring, METH_VARARGS,
+     "add_substring(kind, key, rule, category, end_only) — Aho-Corasick\n"
+     "needle over the full path; end_only restricts to the last byte"},
+    {"add_prefix", (PyCFunction)RuleSet_add_prefix, METH_VARARGS,
+     "add_prefix(kind, key, rule, category) — basename startswith match"},
+    {"add_glob", (PyCFunction)RuleSet_add_glob, METH_VARARGS,
+     "add_glob(kind, pattern, rule, category) — fallback glob, compiled\n"
+     "once into a segment program (fnmatch semantics)"},
+    {"add_path", (PyCFunction)RuleSet_add_path, METH_VARARGS,
+     "add_path(kind, base, rule, category) — literal path-prefix match"},
+    {"build", (PyCFunction)RuleSet_build, METH_NOARGS,
+     "build() — freeze: exact hash table, AC links + goto-table compaction"},
+    {"match", (PyCFunction)RuleSet_match, METH_VARARGS,
+     "match(path, basename, is_dir) -> list[rule] — all tiers in one call;\n"
+     "first match wins per category"},
+    {"match_many", (PyCFunction)RuleSet_match_many, METH_VARARGS,
+     "match_many(items: list[(path, basename, is_dir)]) -> list[list[rule]]\n"
+     "— batch form with the GIL released during matching"},
+    {"save", (PyCFunction)RuleSet_save, METH_VARARGS,
+     "save(path) -> None\n\n"
+     "Dump the built matcher arrays (compacted AC goto table, prefix\n"
+     "trie, exact hash, glob programs) to a warm-start cache file.\n"
+     "Rule objects are not written; load() re-attaches them by index."},
+    {"load", (PyCFunction)RuleSet_load, METH_VARARGS | METH_CLASS,
+     "load(path, rules) -> CompiledRuleSetNative\n\n"
+     "Memory-map a cache written by save() and re-attach *rules* (one\n"
+     "per registered entry, in add_* order).  Skips classification and\n"
+     "the whole build() BFS; the result is already built."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject RuleSetType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "dux._ruleset.CompiledRuleSetNative",
+    .tp_basicsize = sizeof(RuleSetObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Tiered pattern matcher: exact hash, Aho-Corasick, prefix trie,\n"
+              "glob fallback and path prefixes behind one match() call.",
+    .tp_new = RuleSet_new,
+    .tp_dealloc = (destructor)RuleSet_dealloc,
+    .tp_methods = RuleSet_methods,
+};
+
+/* ------------------------------------------------------------------ */
+/* Module definition (multi-phase init for free-threaded compat)      */
+/* ------------------------------------------------------------------ */
+
+static int
+ruleset_exec(PyObject *m)
+{
+    if (PyType_Ready(&RuleSetType) < 0)
+        return -1;
+    if (PyModule_AddObjectRef(m, "CompiledRuleSetNative",
+                              (PyObject *)&RuleSetType) < 0)
+        return -1;
+    return 0;
+}
+
+/* Thread-safety contract: populated single-threaded via add_* + build(),
+ * then match()/match_many() only read — safe for concurrent readers. */
+static PyModuleDef_Slot ruleset_slots[] = {
+    {Py_mod_exec, ruleset_exec},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+static struct PyModuleDef ruleset_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "dux._ruleset",
+    .m_doc = "Native tiered pattern matcher (GIL-free).",
+    .m_size = 0,
+    .m_slots = ruleset_slots,
+};
+
+PyMODINIT_FUNC
+PyInit__ruleset(void)
+{
+    return PyModuleDef_Init(&ruleset_module);
+}
@@ -0,0 +1,1863 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * ScanTree: native struct-of-arrays tree container for scan results.
+ *
+ * A scan of tens of millions of entries allocates that many ScanNode
+ * dataclass instances, each holding a full absolute path string — object
+ * creation and resident memory dominate once I/O is warm.  ScanTree stores
+ * the whole tree as parallel C arrays (name offset, kind, sizes,
+ * first-child/next-sibling links) with all basenames packed into one byte
+ * heap, and hands out lightweight ScanTreeNode handles created lazily only
+ * for the nodes a caller actually touches.  Full paths are never stored:
+ * they are materialized on demand by walking the parent chain.
+ *
+ * Python API:
+ *   tree = ScanTree.scan(path, kind_dir, kind_file, max_depth=-1, prior=None)
+ *   tree.root -> ScanTreeNode        (handle; .name/.path/.kind/.size_bytes/
+ *                                     .disk_usage/.is_dir/.children/.parent)
+ *   tree.node_count / .file_count / .dir_count / .error_count / .root_path
+ *   tree.save(path)                  (flat binary dump of the arrays)
+ *   ScanTree.load(path, kind_dir, kind_file)   (mmap — no deserialization)
+ *   tree.diff(old)                   (merged traversal, per-subtree deltas)
+ *
+ * Handles duck-type ScanNode closely enough for the read-side services
+ * (iter_nodes, top_nodes); size_bytes and disk_usage are writable and go
+ * straight into the arrays, so all handles for the same node agree.
+ */
+
+#define ST_KIND_DIR  0
+#define ST_KIND_FILE 1
+
+/* Nanosecond mtime from struct stat (field name differs on macOS). */
+#ifdef __APPLE__
+#define ST_MTIME_NS(st) \
+    ((long long)(st).st_mtimespec.tv_sec * 1000000000LL + (st).st_mtimespec.tv_nsec)
+#else
+#define ST_MTIME_NS(st) \
+    ((long long)(st).st_mtim.tv_sec * 1000000000LL + (st).st_mtim.tv_nsec)
+#endif
+
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t count;
+    Py_ssize_t capacity;
+    /* Parallel arrays, indexed by node id (0 = root). */
+    Py_ssize_t *name_off;      /* offset of NUL-terminated basename in names */
+    Py_ssize_t *parent;        /* -1 for the root */
+    Py_ssize_t *first_child;   /* -1 = no children */
+    Py_ssize_t *next_sibling;  /* -1 = last sibling */
+    long long *size_bytes;
+    long long *disk_usage;
+    long long *mtime_ns;       /* st_mtime in ns — drives incremental rescan */
+    unsigned char *kind;       /* ST_KIND_DIR / ST_KIND_FILE */
+    /* Packed basename heap. */
+    char *names;
+    Py_ssize_t names_used;
+    Py_ssize_t names_cap;
+    /* Scan counters (dir_count includes the root). */
+    long long file_count;
+    long long dir_count;
+    long long error_count;
+    /* Python objects supplied by the caller, returned by handles. */
+    PyObject *root_path;       /* str — resolved scan root */
+    PyObject *kind_dir;        /* NodeKind.DIRECTORY */
+    PyObject *kind_file;       /* NodeKind.FILE */
+    /* Non-NULL for trees loaded via ScanTree.load(): the arrays point into
+     * this MAP_PRIVATE mapping instead of heap allocations. */
+    void *map_base;
+    size_t map_len;
+} ScanTreeObject;
+
+typedef struct {
+    PyObject_HEAD
+    ScanTreeObject *tree;      /* owned reference — keeps the arrays alive */
+    Py_ssize_t index;
+} ScanTreeNodeObject;
+
+static PyTypeObject ScanTreeType;
+static PyTypeObject ScanTreeNodeType;
+
+/* ------------------------------------------------------------------ */
+/* Array growth                                                       */
+/* ------------------------------------------------------------------ */
+
+static int
+tree_reserve(ScanTreeObject *t)
+{
+    if (t->count < t->capacity)
+        return 0;
+    /* Mapped trees must never grow: the arrays are views into the file
+     * mapping, not realloc-able heap blocks. */
+    if (t->map_base)
+        return -1;
+    Py_ssize_t new_cap = t->capacity * 2;
+
+#define ST_GROW(field, type) do {                                         \
+        type *nw = (type *)realloc(t->field, sizeof(type) * new_cap);     \
+        if (!nw) return -1;                                               \
+        t->field = nw;                                                    \
+    } while (0)
+
+    ST_GROW(name_off, Py_ssize_t);
+    ST_GROW(parent, Py_ssize_t);
+    ST_GROW(first_child, Py_ssize_t);
+    ST_GROW(next_sibling, Py_ssize_t);
+    ST_GROW(size_bytes, long long);
+    ST_GROW(disk_usage, long long);
+    ST_GROW(mtime_ns, long long);
+    ST_GROW(kind, unsigned char);
+#undef ST_GROW
+
+    t->capacity = new_cap;
+    return 0;
+}
+
+static Py_ssize_t
+tree_intern_name(ScanTreeObject *t, const char *name, size_t len)
+{
+    if (t->names_used + (Py_ssize_t)len + 1 > t->names_cap) {
+        Py_ssize_t new_cap = t->names_cap * 2;
+        while (t->names_used + (Py_ssize_t)len + 1 > new_cap)
+            new_cap *= 2;
+        char *nw = (char *)realloc(t->names, new_cap);
+        if (!nw) return -1;
+        t->names = nw;
+        t->names_cap = new_cap;
+    }
+    Py_ssize_t off = t->names_used;
+    memcpy(t->names + off, name, len);
+    t->names[off + len] = '\0';
+    t->names_used += (Py_ssize_t)len + 1;
+    return off;
+}
+
+/* ------------------------------------------------------------------ */
+/* Builder (used while the GIL is released)                           */
+/* ------------------------------------------------------------------ */
+
+/* last_child is scratch used only while filling: it makes sibling links
+ * append in discovery order without a permanent per-node array. */
+typedef struct {
+    ScanTreeObject *t;
+    Py_ssize_t *last_child;
+    Py_ssize_t lc_cap;
+} TreeBuilder;
+
+static Py_ssize_t
+builder_add_node(TreeBuilder *b, Py_ssize_t parent, const char *name,
+                 size_t name_len, unsigned char kind,
+                 long long size, long long disk, long long mtime_ns)
+{
+    ScanTreeObject *t = b->t;
+    if (tree_reserve(t) < 0)
+        return -1;
+    if (t->capacity > b->lc_cap) {
+        Py_ssize_t *nw = (Py_ssize_t *)realloc(
+            b->last_child, sizeof(Py_ssize_t) * t->capacity);
+        if (!nw) return -1;
+        b->last_child = nw;
+        b->lc_cap = t->capacity;
+    }
+
+    Py_ssize_t off = tree_intern_name(t, name, name_len);
+    if (off < 0) return -1;
+
+    Py_ssize_t idx = t->count++;
+    t->name_off[idx] = off;
+    t->parent[idx] = parent;
+    t->first_child[idx] = -1;
+    t->next_sibling[idx] = -1;
+    t->size_bytes[idx] = size;
+    t->disk_usage[idx] = disk;
+    t->mtime_ns[idx] = mtime_ns;
+    t->kind[idx] = kind;
+    b->last_child[idx] = -1;
+
+    if (parent >= 0) {
+        Py_ssize_t prev = b->last_child[parent];
+        if (prev >= 0)
+            t->next_sibling[prev] = idx;
+        else
+            t->first_child[parent] = idx;
+        b->last_child[parent] = idx;
+    }
+    return idx;
+}
+
+/* ------------------------------------------------------------------ */
+/* Path materialization                                               */
+/* ------------------------------------------------------------------ */
+
+/* Build the absolute path of node *idx* into *buf (grown as needed).
+ * Returns the path length, or -1 on OOM. */
+static Py_ssize_t
+tree_abspath(ScanTreeObject *t, const char *root_path, Py_ssize_t idx,
+             char **buf, size_t *buf_cap)
+{
+    /* Collect the parent chain (excluding the root, whose prefix is
+     * root_path itself). */
+    Py_ssize_t chain_stack[64];
+    Py_ssize_t *chain = chain_stack;
+    size_t chain_cap = 64;
+    size_t depth = 0;
+
+    for (Py_ssize_t i = idx; i > 0; i = t->parent[i]) {
+        if (depth >= chain_cap) {
+            size_t new_cap = chain_cap * 2;
+            Py_ssize_t *nw;
+            if (chain == chain_stack) {
+                nw = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * new_cap);
+                if (nw) memcpy(nw, chain, sizeof(Py_ssize_t) * depth);
+            } else {
+                nw = (Py_ssize_t *)realloc(chain, sizeof(Py_ssize_t) * new_cap);
+            }
+            if (!nw) {
+                if (chain != chain_stack) free(chain);
+                return -1;
+            }
+            chain = nw;
+            chain_cap = new_cap;
+        }
+        chain[depth++] = i;
+    }
+
+    size_t rlen = strlen(root_path);
+    size_t total = rlen;
+    for (size_t j = 0; j < depth; j++)
+        total += 1 + strlen(t->names + t->name_off[chain[j]]);
+
+    if (total + 1 > *buf_cap) {
+        size_t new_cap = (*buf_cap ? *buf_cap : 256);
+        while (total + 1 > new_cap)
+            new_cap *= 2;
+        char *nw = (char *)realloc(*buf, new_cap);
+        if (!nw) {
+            if (chain != chain_stack) free(chain);
+            return -1;
+        }
+        *buf = nw;
+        *buf_cap = new_cap;
+    }
+
+    char *out = *buf;
+    memcpy(out, root_path, rlen);
+    size_t pos = rlen;
+    for (size_t j = depth; j-- > 0;) {
+        /* Root "/" already ends with the separator. */
+        if (pos == 0 || out[pos - 1] != '/')
+            out[pos++] = '/';
+        const char *name = t->names + t->name_off[chain[j]];
+        size_t nlen = strlen(name);
+        memcpy(out + pos, name, nlen);
+        pos += nlen;
+    }
+    out[pos] = '\0';
+
+    if (chain != chain_stack) free(chain);
+    return (Py_ssize_t)pos;
+}
+
+/* ------------------------------------------------------------------ */
+/* GIL-free scan fill                                                 */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    Py_ssize_t idx;        /* directory node to expand */
+    Py_ssize_t prior_idx;  /* matching dir in the prior tree, -1 if none */
+    int child_level;       /* level of its children (root's children = 1) */
+} DirTask;
+
+/* Find the child of prior directory *pdir* named *name*.  Directory
+ * listings come back in nearly the same order scan after scan, so the
+ * search resumes from just past the previous hit (*hint) and wraps —
+ * O(1) amortized on unchanged directories instead of O(children). */
+static Py_ssize_t
+prior_find_child(ScanTreeObject *prior, Py_ssize_t pdir, const char *name,
+                 Py_ssize_t *hint)
+{
+    Py_ssize_t start = (*hint >= 0) ? *hint : prior->first_child[pdir];
+    for (Py_ssize_t c = start; c >= 0; c = prior->next_sibling[c]) {
+        if (strcmp(prior->names + prior->name_off[c], name) == 0) {
+            *hint = prior->next_sibling[c];
+            return c;
+        }
+    }
+    for (Py_ssize_t c = prior->first_child[pdir]; c >= 0 && c != start;
+         c = prior->next_sibling[c]) {
+        if (strcmp(prior->names + prior->name_off[c], name) == 0) {
+            *hint = prior->next_sibling[c];
+            return c;
+        }
+    }
+    return -1;
+}
+
+typedef struct {
+    Py_ssize_t src;    /* directory in the prior tree */
+    Py_ssize_t dst;    /* its copy in the tree being built */
+} GraftFrame;
+
+/* Copy every descendant of prior directory *src_root* under the freshly
+ * added node *dst_root*, without touching the filesystem.  Counters are
+ * updated as if the nodes had been scanned. */
+static int
+graft_subtree(TreeBuilder *b, ScanTreeObject *prior, Py_ssize_t src_root,
+              Py_ssize_t dst_root)
+{
+    ScanTreeObject *t = b->t;
+    Py_ssize_t cap = 64;
+    Py_ssize_t size = 0;
+    GraftFrame *stack = (GraftFrame *)malloc(sizeof(GraftFrame) * cap);
+    if (!stack) return -1;
+    int rc = -1;
+
+    stack[size].src = src_root;
+    stack[size].dst = dst_root;
+    size++;
+
+    while (size > 0) {
+        GraftFrame f = stack[--size];
+        for (Py_ssize_t c = prior->first_child[f.src]; c >= 0;
+             c = prior->next_sibling[c]) {
+            const char *name = prior->names + prior->name_off[c];
+            Py_ssize_t idx = builder_add_node(
+                b, f.dst, name, strlen(name), prior->kind[c],
+                prior->size_bytes[c], prior->disk_usage[c],
+                prior->mtime_ns[c]);
+            if (idx < 0) goto done;
+
+            if (prior->kind[c] == ST_KIND_DIR) {
+                t->dir_count++;
+                if (prior->first_child[c] >= 0) {
+                    if (size >= cap) {
+                        Py_ssize_t new_cap = cap * 2;
+                        GraftFrame *nw = (GraftFrame *)realloc(
+                            stack, sizeof(GraftFrame) * new_cap);
+                        if (!nw) goto done;
+                        stack = nw;
+                        cap = new_cap;
+                    }
+                    stack[size].src = c;
+                    stack[size].dst = idx;
+                    size++;
+                }
+            } else {
+                t->file_count++;
+            }
+        }
+    }
+    rc = 0;
+
+done:
+    free(stack);
+    return rc;
+}
+
+/* Walk the filesystem below root_path into the tree arrays.  Directories
+ * whose level exceeds max_depth stay as empty boundary nodes, matching the
+ * Python scanners' max_depth contract.
+ *
+ * When *prior* is non-NULL (incremental rescan), each subdirectory whose
+ * mtime matches its counterpart in the prior tree is grafted wholesale
+ * from the prior arrays instead of being descended into — no opendir, no
+ * stats.  Note the inherent mtime caveat: rewriting an existing file in
+ * place changes the file's mtime but not its parent directory's, so such
+ * size changes are picked up only on the next full scan.
+ *
+ * Returns 0 on success, -1 on OOM, -2 if the root itself could not be
+ * opened (errno is preserved). */
+static int
+tree_fill(ScanTreeObject *t, const char *root_path, Py_ssize_t max_depth,
+          ScanTreeObject *prior)
+{
+    TreeBuilder b = { t, NULL, 0 };
+    char *pathbuf = NULL;
+    size_t pathbuf_cap = 0;
+    int rc = -1;
+
+    Py_ssize_t task_cap = 64;
+    Py_ssize_t task_size = 0;
+    DirTask *tasks = (DirTask *)malloc(sizeof(DirTask) * task_cap);
+    if (!tasks) return -1;
+
+    /* Node 0: the root, named by its basename (root_path for "/"). */
+    const char *root_name = strrchr(root_path, '/');
+    root_name = (root_name && root_name[1]) ? root_name + 1 : root_path;
+    struct stat rst;
+    long long root_mtime = (stat(root_path, &rst) == 0) ? ST_MTIME_NS(rst) : 0;
+    if (builder_add_node(&b, -1, root_name, strlen(root_name),
+                         ST_KIND_DIR, 0, 0, root_mtime) < 0)
+        goto done;
+    t->dir_count = 1;
+
+    tasks[task_size].idx = 0;
+    tasks[task_size].prior_idx = prior ? 0 : -1;
+    tasks[task_size].child_level = 1;
+    task_size++;
+
+    while (task_size > 0) {
+        DirTask task = tasks[--task_size];
+        Py_ssize_t plen = tree_abspath(t, root_path, task.idx,
+                                       &pathbuf, &pathbuf_cap);
+        if (plen < 0) goto done;
+
+        DIR *dp = opendir(pathbuf);
+        if (!dp) {
+            if (task.idx == 0) { rc = -2; goto done; }
+            t->error_count++;
+            continue;
+        }
+        int dfd = dirfd(dp);
+        Py_ssize_t hint = -1;  /* prior_find_child resume point, per dir */
+
+        struct dirent *ep;
+        while ((ep = readdir(dp)) != NULL) {
+            if (ep->d_name[0] == '.') {
+                if (ep->d_name[1] == '\0') continue;
+                if (ep->d_name[1] == '.' && ep->d_name[2] == '\0') continue;
+            }
+
+            struct stat st;
+            if (fstatat(dfd, ep->d_name, &st, AT_SYMLINK_NOFOLLOW) < 0) {
+                t->error_count++;
+                continue;
+            }
+
+            int is_dir = S_ISDIR(st.st_mode);
+            long long size = is_dir ? 0 : (long long)st.st_size;
+            long long disk = is_dir ? 0 : (long long)st.st_blocks * 512;
+
+            Py_ssize_t idx = builder_add_node(
+                &b, task.idx, ep->d_name, strlen(ep->d_name),
+                is_dir ? ST_KIND_DIR : ST_KIND_FILE, size, disk,
+                ST_MTIME_NS(st));
+            if (idx < 0) { closedir(dp); goto done; }
+
+            if (is_dir) {
+                t->dir_count++;
+                if (max_depth < 0 || task.child_level <= max_depth) {
+                    Py_ssize_t pidx = -1;
+                    if (task.prior_idx >= 0)
+                        pidx = prior_find_child(prior, task.prior_idx,
+                                                ep->d_name, &hint);
+                    if (pidx >= 0 && prior->kind[pidx] == ST_KIND_DIR
+                        && prior->mtime_ns[pidx] == ST_MTIME_NS(st)) {
+                        /* Unchanged: reuse the prior subtree, no descent. */
+                        if (graft_subtree(&b, prior, pidx, idx) < 0) {
+                            closedir(dp);
+                            goto done;
+                        }
+                        continue;
+                    }
+                    if (task_size >= task_cap) {
+                        Py_ssize_t new_cap = task_cap * 2;
+                        DirTask *nw = (DirTask *)realloc(
+                            tasks, sizeof(DirTask) * new_cap);
+                        if (!nw) { closedir(dp); goto done; }
+                        tasks = nw;
+                        task_cap = new_cap;
+                    }
+                    tasks[task_size].idx = idx;
+                    tasks[task_size].prior_idx = pidx;
+                    tasks[task_size].child_level = task.child_level + 1;
+                    task_size++;
+                }
+            } else {
+                t->file_count++;
+            }
+        }
+        closedir(dp);
+    }
+
+    rc = 0;
+
+done:
+    free(b.last_child);
+    free(pathbuf);
+    free(tasks);
+    return rc;
+}
+
+/* ------------------------------------------------------------------ */
+/* Finalize: bottom-up aggregation + child sort (GIL released)        */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    long long disk;
+    Py_ssize_t idx;
+} ChildSortItem;
+
+/* disk_usage descending, node id ascending as the tie-break so the
+ * order is deterministic across repeated finalize calls. */
+static int
+child_sort_cmp(const void *a, const void *b)
+{
+    const ChildSortItem *x = (const ChildSortItem *)a;
+    const ChildSortItem *y = (const ChildSortItem *)b;
+    if (x->disk != y->disk)
+        return (x->disk < y->disk) ? 1 : -1;
+    return (x->idx < y->idx) ? -1 : (x->idx > y->idx);
+}
+
+/* Sum child sizes into directories and sort each directory's children by
+ * disk_usage descending — the native equivalent of finalize_sizes in
+ * dux/services/tree.py, over the arrays only.  Idempotent: directory
+ * aggregates are reset before summing.  Returns 0, or -1 on OOM. */
+static int
+tree_finalize_impl(ScanTreeObject *t)
+{
+    for (Py_ssize_t i = 0; i < t->count; i++) {
+        if (t->kind[i] == ST_KIND_DIR) {
+            t->size_bytes[i] = 0;
+            t->disk_usage[i] = 0;
+        }
+    }
+
+    /* Children are always appended after their parent during the top-down
+     * fill, so one reverse index pass is a bottom-up aggregation. */
+    for (Py_ssize_t i = t->count - 1; i > 0; i--) {
+        Py_ssize_t p = t->parent[i];
+        t->size_bytes[p] += t->size_bytes[i];
+        t->disk_usage[p] += t->disk_usage[i];
+    }
+
+    ChildSortItem *buf = NULL;
+    Py_ssize_t buf_cap = 0;
+
+    for (Py_ssize_t i = 0; i < t->count; i++) {
+        if (t->first_child[i] < 0)
+            continue;
+
+        Py_ssize_t n = 0;
+        for (Py_ssize_t c = t->first_child[i]; c >= 0; c = t->next_sibling[c]) {
+            if (n >= buf_cap) {
+                Py_ssize_t new_cap = buf_cap ? buf_cap * 2 : 64;
+                ChildSortItem *nw = (ChildSortItem *)realloc(
+                    buf, sizeof(ChildSortItem) * new_cap);
+                if (!nw) { free(buf); return -1; }
+                buf = nw;
+                buf_cap = new_cap;
+            }
+            buf[n].disk = t->disk_usage[c];
+            buf[n].idx = c;
+            n++;
+        }
+        if (n < 2)
+            continue;
+
+        qsort(buf, n, sizeof(ChildSortItem), child_sort_cmp);
+
+        t->first_child[i] = buf[0].idx;
+        for (Py_ssize_t j = 0; j < n - 1; j++)
+            t->next_sibling[buf[j].idx] = buf[j + 1].idx;
+        t->next_sibling[buf[n - 1].idx] = -1;
+    }
+
+    free(buf);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Snapshot diff (merged traversal over two trees' arrays)            */
+/* ------------------------------------------------------------------ */
+
+#define ST_DIFF_CHANGED 0
+#define ST_DIFF_ADDED   1
+#define ST_DIFF_REMOVED 2
+
+typedef struct {
+    Py_ssize_t path_off;       /* into DiffOut.paths */
+    long long dsize;
+    long long ddisk;
+    long long added;           /* nodes new in this subtree */
+    long long removed;         /* nodes gone from this subtree */
+    unsigned char is_dir;
+    unsigned char status;
+} DiffRec;
+
+typedef struct {
+    DiffRec *recs;
+    Py_ssize_t rec_count;
+    Py_ssize_t rec_cap;
+    char *paths;               /* packed NUL-terminated record paths */
+    Py_ssize_t paths_used;
+    Py_ssize_t paths_cap;
+    char *cur;                 /* absolute path of the DFS position */
+    size_t cur_len;
+    size_t cur_cap;
+} DiffOut;
+
+typedef struct {
+    long long dsize;
+    long long ddisk;
+    long long added;
+    long long removed;
+    int changed;
+} DiffAgg;
+
+static int
+diff_path_push(DiffOut *o, const char *name, size_t *saved_len)
+{
+    *saved_len = o->cur_len;
+    size_t nlen = strlen(name);
+    size_t need = o->cur_len + 1 + nlen + 1;
+    if (need > o->cur_cap) {
+        size_t new_cap = o->cur_cap ? o->cur_cap : 256;
+        while (need > new_cap)
+            new_cap *= 2;
+        char *nw = (char *)realloc(o->cur, new_cap);
+        if (!nw) return -1;
+        o->cur = nw;
+        o->cur_cap = new_cap;
+    }
+    if (o->cur_len == 0 || o->cur[o->cur_len - 1] != '/')
+        o->cur[o->cur_len++] = '/';
+    memcpy(o->cur + o->cur_len, name, nlen);
+    o->cur_len += nlen;
+    o->cur[o->cur_len] = '\0';
+    return 0;
+}
+
+static void
+diff_path_pop(DiffOut *o, size_t saved_len)
+{
+    o->cur_len = saved_len;
+    o->cur[saved_len] = '\0';
+}
+
+static int
+diff_emit(DiffOut *o, unsigned char status, unsigned char is_dir,
+          long long dsize, long long ddisk, long long added, long long removed)
+{
+    if (o->paths_used + (Py_ssize_t)o->cur_len + 1 > o->paths_cap) {
+        Py_ssize_t new_cap = o->paths_cap ? o->paths_cap : 4096;
+        while (o->paths_used + (Py_ssize_t)o->cur_len + 1 > new_cap)
+            new_cap *= 2;
+        char *nw = (char *)realloc(o->paths, new_cap);
+        if (!nw) return -1;
+        o->paths = nw;
+        o->paths_cap = new_cap;
+    }
+    if (o->rec_count >= o->rec_cap) {
+        Py_ssize_t new_cap = o->rec_cap ? o->rec_cap * 2 : 64;
+        DiffRec *nw = (DiffRec *)realloc(o->recs, sizeof(DiffRec) * new_cap);
+        if (!nw) return -1;
+        o->recs = nw;
+        o->rec_cap = new_cap;
+    }
+
+    Py_ssize_t off = o->paths_used;
+    memcpy(o->paths + off, o->cur, o->cur_len + 1);
+    o->paths_used += (Py_ssize_t)o->cur_len + 1;
+
+    DiffRec *r = &o->recs[o->rec_count++];
+    r->path_off = off;
+    r->dsize = dsize;
+    r->ddisk = ddisk;
+    r->added = added;
+    r->removed = removed;
+    r->is_dir = is_dir;
+    r->status = status;
+    return 0;
+}
+
+/* Sum file sizes and count all nodes of the subtree at *idx*.  Recursion
+ * depth equals filesystem depth, which is path-length bounded. */
+static void
+subtree_totals(ScanTreeObject *t, Py_ssize_t idx,
+               long long *size, long long *disk, long long *nodes)
+{
+    *nodes += 1;
+    if (t->kind[idx] == ST_KIND_FILE) {
+        *size += t->size_bytes[idx];
+        *disk += t->disk_usage[idx];
+        return;
+    }
+    for (Py_ssize_t c = t->first_child[idx]; c >= 0; c = t->next_sibling[c])
+        subtree_totals(t, c, size, disk, nodes);
+}
+
+/* Emit an ADDED record for the new subtree at *ni* (path already pushed). */
+static int
+diff_added(ScanTreeObject *tn, Py_ssize_t ni, DiffOut *o, DiffAgg *agg)
+{
+    long long sz = 0, dk = 0, n = 0;
+    subtree_totals(tn, ni, &sz, &dk, &n);
+    if (diff_emit(o, ST_DIFF_ADDED, tn->kind[ni] == ST_KIND_DIR,
+                  sz, dk, n, 0) < 0)
+        return -1;
+    agg->dsize += sz;
+    agg->ddisk += dk;
+    agg->added += n;
+    agg->changed = 1;
+    return 0;
+}
+
+/* Emit a REMOVED record for the old subtree at *oi* (path already pushed). */
+static int
+diff_removed(ScanTreeObject *to, Py_ssize_t oi, DiffOut *o, DiffAgg *agg)
+{
+    long long sz = 0, dk = 0, n = 0;
+    subtree_totals(to, oi, &sz, &dk, &n);
+    if (diff_emit(o, ST_DIFF_REMOVED, to->kind[oi] == ST_KIND_DIR,
+                  -sz, -dk, 0, n) < 0)
+        return -1;
+    agg->dsize -= sz;
+    agg->ddisk -= dk;
+    agg->removed += n;
+    agg->changed = 1;
+    return 0;
+}
+
+/* Merged DFS over the matched directory pair (ni in the new tree, oi in
+ * the old).  Children are matched by name (resume-hint search, same idea
+ * as prior_find_child); deltas bubble up through *agg* and a CHANGED
+ * record is emitted for every directory whose subtree differs, giving
+ * per-subtree growth attribution.  Dir deltas are computed from file
+ * sums, so neither tree needs to be finalized.  Returns 0 or -1 (OOM). */
+static int
+diff_dirs(ScanTreeObject *tn, Py_ssize_t ni,
+          ScanTreeObject *to, Py_ssize_t oi,
+          DiffOut *o, DiffAgg *agg)
+{
+    DiffAgg mine = {0, 0, 0, 0, 0};
+    int rc = -1;
+
+    Py_ssize_t ocount = 0;
+    for (Py_ssize_t c = to->first_child[oi]; c >= 0; c = to->next_sibling[c])
+        ocount++;
+
+    Py_ssize_t *oidx = NULL;
+    unsigned char *omatched = NULL;
+    if (ocount > 0) {
+        oidx = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * ocount);
+        omatched = (unsigned char *)calloc((size_t)ocount, 1);
+        if (!oidx || !omatched)
+            goto done;
+        Py_ssize_t j = 0;
+        for (Py_ssize_t c = to->first_child[oi]; c >= 0;
+             c = to->next_sibling[c])
+            oidx[j++] = c;
+    }
+
+    Py_ssize_t hint = 0;
+    for (Py_ssize_t c = tn->first_child[ni]; c >= 0; c = tn->next_sibling[c]) {
+        const char *name = tn->names + tn->name_off[c];
+        Py_ssize_t found = -1;
+        for (Py_ssize_t k = 0; k < ocount; k++) {
+            Py_ssize_t j = (hint + k) % ocount;
+            if (!omatched[j]
+                && strcmp(to->names + to->name_off[oidx[j]], name) == 0) {
+                found = j;
+                hint = j + 1;
+                break;
+            }
+        }
+
+        size_t saved;
+        if (diff_path_push(o, name, &saved) < 0)
+            goto done;
+
+        if (found < 0) {
+            if (diff_added(tn, c, o, &mine) < 0)
+                goto done;
+        } else {
+            omatched[found] = 1;
+            Py_ssize_t od = oidx[found];
+            int new_is_dir = (tn->kind[c] == ST_KIND_DIR);
+            int old_is_dir = (to->kind[od] == ST_KIND_DIR);
+            if (new_is_dir && old_is_dir) {
+                DiffAgg sub = {0, 0, 0, 0, 0};
+                if (diff_dirs(tn, c, to, od, o, &sub) < 0)
+                    goto done;
+                if (sub.changed
+                    && diff_emit(o, ST_DIFF_CHANGED, 1, sub.dsize, sub.ddisk,
+                                 sub.added, sub.removed) < 0)
+                    goto done;
+                mine.dsize += sub.dsize;
+                mine.ddisk += sub.ddisk;
+                mine.added += sub.added;
+                mine.removed += sub.removed;
+                mine.changed |= sub.changed;
+            } else if (!new_is_dir && !old_is_dir) {
+                long long ds = tn->size_bytes[c] - to->size_bytes[od];
+                long long dd = tn->disk_usage[c] - to->disk_usage[od];
+                if (ds || dd) {
+                    if (diff_emit(o, ST_DIFF_CHANGED, 0, ds, dd, 0, 0) < 0)
+                        goto done;
+                    mine.dsize += ds;
+                    mine.ddisk += dd;
+                    mine.changed = 1;
+                }
+            } else {
+                /* Kind flip (file became dir or vice versa): the old
+                 * subtree is gone, a new one took its path. */
+                if (diff_removed(to, od, o, &mine) < 0
+                    || diff_added(tn, c, o, &mine) < 0)
+                    goto done;
+            }
+        }
+        diff_path_pop(o, saved);
+    }
+
+    for (Py_ssize_t j = 0; j < ocount; j++) {
+        if (omatched[j])
+            continue;
+        size_t saved;
+        if (diff_path_push(o, to->names + to->name_off[oidx[j]], &saved) < 0)
+            goto done;
+        if (diff_removed(to, oidx[j], o, &mine) < 0)
+            goto done;
+        diff_path_pop(o, saved);
+    }
+
+    agg->dsize += mine.dsize;
+    agg->ddisk += mine.ddisk;
+    agg->added += mine.added;
+    agg->removed += mine.removed;
+    agg->changed |= mine.changed;
+    rc = 0;
+
+done:
+    free(oidx);
+    free(omatched);
+    return rc;
+}
+
+/* ------------------------------------------------------------------ */
+/* ScanTreeNode handle                                                */
+/* ------------------------------------------------------------------ */
+
+static PyObject *
+node_new(ScanTreeObject *tree, Py_ssize_t index)
+{
+    ScanTreeNodeObject *self = (ScanTreeNodeObject *)
+        ScanTreeNodeType.tp_alloc(&ScanTreeNodeType, 0);
+    if (!self) return NULL;
+    Py_INCREF(tree);
+    self->tree = tree;
+    self->index = index;
+    return (PyObject *)self;
+}
+
+static void
+node_dealloc(ScanTreeNodeObject *self)
+{
+    Py_XDECREF(self->tree);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+node_get_name(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    ScanTreeObject *t = self->tree;
+    return PyUnicode_FromString(t->names + t->name_off[self->index]);
+}
+
+static PyObject *
+node_get_path(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    ScanTreeObject *t = self->tree;
+    if (self->index == 0)
+        return Py_NewRef(t->root_path);
+
+    const char *root_path = PyUnicode_AsUTF8(t->root_path);
+    if (!root_path) return NULL;
+
+    char *buf = NULL;
+    size_t cap = 0;
+    Py_ssize_t len = tree_abspath(t, root_path, self->index, &buf, &cap);
+    if (len < 0) {
+        free(buf);
+        return PyErr_NoMemory();
+    }
+    PyObject *result = PyUnicode_FromStringAndSize(buf, len);
+    free(buf);
+    return result;
+}
+
+static PyObject *
+node_get_kind(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    ScanTreeObject *t = self->tree;
+    PyObject *kind = (t->kind[self->index] == ST_KIND_DIR)
+        ? t->kind_dir : t->kind_file;
+    return Py_NewRef(kind);
+}
+
+static PyObject *
+node_get_is_dir(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return PyBool_FromLong(self->tree->kind[self->index] == ST_KIND_DIR);
+}
+
+static PyObject *
+node_get_size_bytes(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->tree->size_bytes[self->index]);
+}
+
+static int
+node_set_size_bytes(ScanTreeNodeObject *self, PyObject *value, void *closure)
+{
+    (void)closure;
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete size_bytes");
+        return -1;
+    }
+    long long v = PyLong_AsLongLong(value);
+    if (v == -1 && PyErr_Occurred())
+        return -1;
+    self->tree->size_bytes[self->index] = v;
+    return 0;
+}
+
+static PyObject *
+node_get_disk_usage(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->tree->disk_usage[self->index]);
+}
+
+static int
+node_set_disk_usage(ScanTreeNodeObject *self, PyObject *value, void *closure)
+{
+    (void)closure;
+    if (!value) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete disk_usage");
+        return -1;
+    }
+    long long v = PyLong_AsLongLong(value);
+    if (v == -1 && PyErr_Occurred())
+        return -1;
+    self->tree->disk_usage[self->index] = v;
+    return 0;
+}
+
+static PyObject *
+node_get_children(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    ScanTreeObject *t = self->tree;
+    PyObject *list = PyList_New(0);
+    if (!list) return NULL;
+    for (Py_ssize_t c = t->first_child[self->index]; c >= 0;
+         c = t->next_sibling[c]) {
+        PyObject *h = node_new(t, c);
+        if (!h || PyList_Append(list, h) < 0) {
+            Py_XDECREF(h);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(h);
+    }
+    return list;
+}
+
+static PyObject *
+node_get_parent(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    Py_ssize_t p = self->tree->parent[self->index];
+    if (p < 0)
+        Py_RETURN_NONE;
+    return node_new(self->tree, p);
+}
+
+static PyObject *
+node_get_index(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromSsize_t(self->index);
+}
+
+static PyObject *
+node_get_mtime_ns(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->tree->mtime_ns[self->index]);
+}
+
+static PyObject *
+node_get_tree(ScanTreeNodeObject *self, void *closure)
+{
+    (void)closure;
+    return Py_NewRef((PyObject *)self->tree);
+}
+
+static PyGetSetDef ScanTreeNode_getset[] = {
+    {"name", (getter)node_get_name, NULL, "basename of this node", NULL},
+    {"path", (getter)node_get_path, NULL,
+     "absolute path, materialized on demand from the parent chain", NULL},
+    {"kind", (getter)node_get_kind, NULL, "NodeKind of this node", NULL},
+    {"is_dir", (getter)node_get_is_dir, NULL, "True for directories", NULL},
+    {"size_bytes", (getter)node_get_size_bytes, (setter)node_set_size_bytes,
+     "logical size in bytes (writes go into the tree arrays)", NULL},
+    {"disk_usage", (getter)node_get_disk_usage, (setter)node_set_disk_usage,
+     "allocated size in bytes (writes go into the tree arrays)", NULL},
+    {"children", (getter)node_get_children, NULL,
+     "list of child handles (created lazily per access)", NULL},
+    {"parent", (getter)node_get_parent, NULL,
+     "parent handle, or None for the root", NULL},
+    {"index", (getter)node_get_index, NULL, "node id within the tree", NULL},
+    {"mtime_ns", (getter)node_get_mtime_ns, NULL,
+     "st_mtime at scan time, in nanoseconds", NULL},
+    {"tree", (getter)node_get_tree, NULL, "the owning ScanTree", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyObject *
+node_richcompare(PyObject *a, PyObject *b, int op)
+{
+    if ((op != Py_EQ && op != Py_NE)
+        || !PyObject_TypeCheck(a, &ScanTreeNodeType)
+        || !PyObject_TypeCheck(b, &ScanTreeNodeType))
+        Py_RETURN_NOTIMPLEMENTED;
+    ScanTreeNodeObject *na = (ScanTreeNodeObject *)a;
+    ScanTreeNodeObject *nb = (ScanTreeNodeObject *)b;
+    int eq = (na->tree == nb->tree && na->index == nb->index);
+    if (op == Py_NE) eq = !eq;
+    return PyBool_FromLong(eq);
+}
+
+static PyTypeObject ScanTreeNodeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "dux._scan_tree.ScanTreeNode",
+    .tp_basicsize = sizeof(ScanTreeNodeObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Lightweight handle to one node of a ScanTree.",
+    .tp_dealloc = (destructor)node_dealloc,
+    .tp_getset = ScanTreeNode_getset,
+    .tp_richcompare = node_richcompare,
+};
+
+/* ------------------------------------------------------------------ */
+/* ScanTree                                                           */
+/* ------------------------------------------------------------------ */
+
+static void
+tree_dealloc(ScanTreeObject *self)
+{
+    if (self->map_base) {
+        munmap(self->map_base, self->map_len);
+    } else {
+        free(self->name_off);
+        free(self->parent);
+        free(self->first_child);
+        free(self->next_sibling);
+        free(self->size_bytes);
+        free(self->disk_usage);
+        free(self->mtime_ns);
+        free(self->kind);
+        free(self->names);
+    }
+    Py_XDECREF(self->root_path);
+    Py_XDECREF(self->kind_dir);
+    Py_XDECREF(self->kind_file);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+#define ST_INITIAL_CAP 1024
+#define ST_INITIAL_NAMES (16 * 1024)
+
+static ScanTreeObject *
+tree_alloc_empty(void)
+{
+    ScanTreeObject *t = (ScanTreeObject *)
+        ScanTreeType.tp_alloc(&ScanTreeType, 0);
+    if (!t) return NULL;
+
+    t->count = 0;
+    t->capacity = ST_INITIAL_CAP;
+    t->name_off = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * ST_INITIAL_CAP);
+    t->parent = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * ST_INITIAL_CAP);
+    t->first_child = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * ST_INITIAL_CAP);
+    t->next_sibling = (Py_ssize_t *)malloc(sizeof(Py_ssize_t) * ST_INITIAL_CAP);
+    t->size_bytes = (long long *)malloc(sizeof(long long) * ST_INITIAL_CAP);
+    t->disk_usage = (long long *)malloc(sizeof(long long) * ST_INITIAL_CAP);
+    t->mtime_ns = (long long *)malloc(sizeof(long long) * ST_INITIAL_CAP);
+    t->kind = (unsigned char *)malloc(ST_INITIAL_CAP);
+    t->names = (char *)malloc(ST_INITIAL_NAMES);
+    t->names_used = 0;
+    t->names_cap = ST_INITIAL_NAMES;
+    t->file_count = 0;
+    t->dir_count = 0;
+    t->error_count = 0;
+    t->root_path = NULL;
+    t->kind_dir = NULL;
+    t->kind_file = NULL;
+    t->map_base = NULL;
+    t->map_len = 0;
+
+    if (!t->name_off || !t->parent || !t->first_child || !t->next_sibling
+        || !t->size_bytes || !t->disk_usage || !t->mtime_ns || !t->kind
+        || !t->names) {
+        Py_DECREF(t);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    return t;
+}
+
+static PyObject *
+tree_scan(PyObject *cls, PyObject *args, PyObject *kwargs)
+{
+    (void)cls;
+    static char *kwlist[] = {"path", "kind_dir", "kind_file", "max_depth",
+                             "prior", NULL};
+    PyObject *path_obj, *kind_dir, *kind_file;
+    PyObject *prior_obj = Py_None;
+    Py_ssize_t max_depth = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "UOO|nO", kwlist,
+                                     &path_obj, &kind_dir, &kind_file,
+                                     &max_depth, &prior_obj))
+        return NULL;
+
+    ScanTreeObject *prior = NULL;
+    if (prior_obj != Py_None) {
+        if (!PyObject_TypeCheck(prior_obj, &ScanTreeType)) {
+            PyErr_SetString(PyExc_TypeError, "prior must be a ScanTree");
+            return NULL;
+        }
+        prior = (ScanTreeObject *)prior_obj;
+        int cmp = PyUnicode_Compare(prior->root_path, path_obj);
+        if (cmp == -1 && PyErr_Occurred())
+            return NULL;
+        if (cmp != 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "prior snapshot was taken for a different root path");
+            return NULL;
+        }
+    }
+
+    const char *root_path = PyUnicode_AsUTF8(path_obj);
+    if (!root_path)
+        return NULL;
+
+    ScanTreeObject *t = tree_alloc_empty();
+    if (!t)
+        return NULL;
+    t->root_path = Py_NewRef(path_obj);
+    t->kind_dir = Py_NewRef(kind_dir);
+    t->kind_file = Py_NewRef(kind_file);
+
+    int rc;
+    /* Same two-phase contract as the walker: the whole filesystem walk
+     * runs with the GIL released; no Python objects are created until the
+     * arrays are complete. */
+    /* prior is a borrowed reference kept alive by the args tuple; its
+     * arrays are only read. */
+    Py_BEGIN_ALLOW_THREADS
+    rc = tree_fill(t, root_path, max_depth, prior);
+    Py_END_ALLOW_THREADS
+
+    if (rc == -2) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+        Py_DECREF(t);
+        return NULL;
+    }
+    if (rc < 0) {
+        Py_DECREF(t);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)t;
+}
+
+/* ------------------------------------------------------------------ */
+/* Binary snapshot format                                             */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Layout (all integers little-endian int64, written natively — the format
+ * is a same-machine cache, not an interchange format):
+ *
+ *   SnapHeader                       (64 bytes, magic "DUXTREE2")
+ *   root_path bytes                  (UTF-8, padded to 8)
+ *   name_off / parent / first_child / next_sibling   (count x int64 each)
+ *   size_bytes / disk_usage / mtime_ns               (count x int64 each)
+ *   kind                             (count x uint8)
+ *   names                            (names_used bytes)
+ *
+ * load() maps the whole file MAP_PRIVATE and points the tree arrays
+ * directly into the mapping: no records are parsed and no Python objects
+ * are created until a handle is touched, so load time is dominated by
+ * page-cache faulting.  MAP_PRIVATE makes the mapping copy-on-write, so
+ * finalize() and the size setters still work without dirtying the file.
+ */
+
+#define SNAP_MAGIC "DUXTREE2"
+
+typedef struct {
+    char magic[8];
+    int64_t count;
+    int64_t names_used;
+    int64_t file_count;
+    int64_t dir_count;
+    int64_t error_count;
+    int64_t root_path_len;     /* bytes, excluding padding */
+    int64_t reserved;          /* zero; keeps the header at 64 bytes */
+} SnapHeader;
+
+/* The arrays are dumped and mapped as int64; Py_ssize_t must match. */
+_Static_assert(sizeof(Py_ssize_t) == sizeof(int64_t),
+               "snapshot format requires 64-bit Py_ssize_t");
+_Static_assert(sizeof(long long) == sizeof(int64_t),
+               "snapshot format requires 64-bit long long");
+_Static_assert(sizeof(SnapHeader) == 64, "snapshot header must be 64 bytes");
+
+static size_t
+snap_pad8(size_t n)
+{
+    return (n + 7) & ~(size_t)7;
+}
+
+/* write() until done; returns 0 or -1 with errno set. */
+static int
+write_all(int fd, const void *buf, size_t len)
+{
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int
+snap_write(ScanTreeObject *t, int fd, const char *root_path, size_t rlen)
+{
+    SnapHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, SNAP_MAGIC, 8);
+    hdr.count = (int64_t)t->count;
+    hdr.names_used = (int64_t)t->names_used;
+    hdr.file_count = t->file_count;
+    hdr.dir_count = t->dir_count;
+    hdr.error_count = t->error_count;
+    hdr.root_path_len = (int64_t)rlen;
+
+    static const char zeros[8] = {0};
+    size_t n = (size_t)t->count;
+
+    if (write_all(fd, &hdr, sizeof(hdr)) < 0) return -1;
+    if (write_all(fd, root_path, rlen) < 0) return -1;
+    if (write_all(fd, zeros, snap_pad8(rlen) - rlen) < 0) return -1;
+    if (write_all(fd, t->name_off, n * 8) < 0) return -1;
+    if (write_all(fd, t->parent, n * 8) < 0) return -1;
+    if (write_all(fd, t->first_child, n * 8) < 0) return -1;
+    if (write_all(fd, t->next_sibling, n * 8) < 0) return -1;
+    if (write_all(fd, t->size_bytes, n * 8) < 0) return -1;
+    if (write_all(fd, t->disk_usage, n * 8) < 0) return -1;
+    if (write_all(fd, t->mtime_ns, n * 8) < 0) return -1;
+    if (write_all(fd, t->kind, n) < 0) return -1;
+    if (write_all(fd, t->names, (size_t)t->names_used) < 0) return -1;
+    return 0;
+}
+
+static PyObject *
+tree_save(ScanTreeObject *self, PyObject *args)
+{
+    PyObject *path_obj;
+    if (!PyArg_ParseTuple(args, "U", &path_obj))
+        return NULL;
+
+    const char *path = PyUnicode_AsUTF8(path_obj);
+    if (!path) return NULL;
+    const char *root_path = PyUnicode_AsUTF8(self->root_path);
+    if (!root_path) return NULL;
+    size_t rlen = strlen(root_path);
+
+    int fd, rc;
+    Py_BEGIN_ALLOW_THREADS
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    rc = (fd < 0) ? -1 : snap_write(self, fd, root_path, rlen);
+    if (fd >= 0 && close(fd) < 0)
+        rc = -1;
+    Py_END_ALLOW_THREADS
+
+    if (rc < 0)
+        return PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+tree_load(PyObject *cls, PyObject *args)
+{
+    (void)cls;
+    PyObject *path_obj, *kind_dir, *kind_file;
+    if (!PyArg_ParseTuple(args, "UOO", &path_obj, &kind_dir, &kind_file))
+        return NULL;
+
+    const char *path = PyUnicode_AsUTF8(path_obj);
+    if (!path) return NULL;
+
+    void *base = MAP_FAILED;
+    size_t map_len = 0;
+    Py_BEGIN_ALLOW_THREADS
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            if (st.st_size >= (off_t)sizeof(SnapHeader)) {
+                map_len = (size_t)st.st_size;
+                /* PROT_WRITE + MAP_PRIVATE: writes (finalize, size
+                 * setters) go to copy-on-write pages; the file is never
+                 * dirtied. */
+                base = mmap(NULL, map_len, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE, fd, 0);
+            } else {
+                errno = EINVAL;
+            }
+        }
+        close(fd);
+    }
+    Py_END_ALLOW_THREADS
+
+    if (base == MAP_FAILED)
+        return PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+
+    SnapHeader *hdr = (SnapHeader *)base;
+    size_t n = (size_t)hdr->count;
+    size_t rlen = (size_t)hdr->root_path_len;
+    size_t expected = sizeof(SnapHeader) + snap_pad8(rlen)
+        + n * 8 * 7 + n + (size_t)hdr->names_used;
+    if (memcmp(hdr->magic, SNAP_MAGIC, 8) != 0
+        || hdr->count < 1 || hdr->names_used < 0 || hdr->root_path_len < 0
+        || expected != map_len) {
+        munmap(base, map_len);
+        PyErr_Format(PyExc_ValueError,
+                     "not a dux snapshot (bad magic or truncated): %U",
+                     path_obj);
+        return NULL;
+    }
+
+    /* Per-element validation.  Snapshots are user-supplied input, and
+     * the header check only proves the file length is self-consistent —
+     * a corrupted file with in-range counts would otherwise hand out
+     * wild indices that crash on first traversal.  One linear pass over
+     * the mapped arrays keeps load O(n); the node data itself is still
+     * never deserialized. */
+    int valid = 1;
+    {
+        char *q = (char *)base + sizeof(SnapHeader) + snap_pad8(rlen);
+        Py_ssize_t *name_off = (Py_ssize_t *)q;
+        Py_ssize_t *parent = (Py_ssize_t *)(q + n * 8);
+        Py_ssize_t *first_child = (Py_ssize_t *)(q + n * 8 * 2);
+        Py_ssize_t *next_sibling = (Py_ssize_t *)(q + n * 8 * 3);
+        unsigned char *kind = (unsigned char *)(q + n * 8 * 7);
+        const char *names = q + n * 8 * 7 + n;
+        Py_ssize_t names_used = (Py_ssize_t)hdr->names_used;
+        Py_ssize_t count = (Py_ssize_t)n;
+        Py_BEGIN_ALLOW_THREADS
+        /* Name lookups strlen() from their offset; a terminating NUL at
+         * the end of the pool bounds every one of them.  count >= 1
+         * implies at least the root's (possibly empty) name is stored. */
+        if (names_used < 1 || names[names_used - 1] != '\0')
+            valid = 0;
+        for (Py_ssize_t i = 0; valid && i < count; i++) {
+            if (name_off[i] < 0 || name_off[i] >= names_used
+                || parent[i] < -1 || parent[i] >= count
+                || first_child[i] < -1 || first_child[i] >= count
+                || next_sibling[i] < -1 || next_sibling[i] >= count
+                || kind[i] > ST_KIND_FILE)
+                valid = 0;
+        }
+        Py_END_ALLOW_THREADS
+    }
+    if (!valid) {
+        munmap(base, map_len);
+        PyErr_Format(PyExc_ValueError,
+                     "not a dux snapshot (corrupt node arrays): %U",
+                     path_obj);
+        return NULL;
+    }
+
+    ScanTreeObject *t = (ScanTreeObject *)
+        ScanTreeType.tp_alloc(&ScanTreeType, 0);
+    if (!t) {
+        munmap(base, map_len);
+        return NULL;
+    }
+
+    char *p = (char *)base + sizeof(SnapHeader);
+    t->root_path = PyUnicode_FromStringAndSize(p, (Py_ssize_t)rlen);
+    p += snap_pad8(rlen);
+    t->count = (Py_ssize_t)n;
+    t->capacity = (Py_ssize_t)n;       /* full: mapped trees never grow */
+    t->name_off = (Py_ssize_t *)p;     p += n * 8;
+    t->parent = (Py_ssize_t *)p;       p += n * 8;
+    t->first_child = (Py_ssize_t *)p;  p += n * 8;
+    t->next_sibling = (Py_ssize_t *)p; p += n * 8;
+    t->size_bytes = (long long *)p;    p += n * 8;
+    t->disk_usage = (long long *)p;    p += n * 8;
+    t->mtime_ns = (long long *)p;      p += n * 8;
+    t->kind = (unsigned char *)p;      p += n;
+    t->names = p;
+    t->names_used = (Py_ssize_t)hdr->names_used;
+    t->names_cap = (Py_ssize_t)hdr->names_used;
+    t->file_count = hdr->file_count;
+    t->dir_count = hdr->dir_count;
+    t->error_count = hdr->error_count;
+    t->kind_dir = Py_NewRef(kind_dir);
+    t->kind_file = Py_NewRef(kind_file);
+    t->map_base = base;
+    t->map_len = map_len;
+
+    if (!t->root_path) {
+        /* dealloc munmaps map_base for us */
+        Py_DECREF(t);
+        return NULL;
+    }
+    return (PyObject *)t;
+}
+
+static PyObject *
+tree_get_root(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    if (self->count == 0)
+        Py_RETURN_NONE;
+    return node_new(self, 0);
+}
+
+static PyObject *
+tree_get_node_count(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromSsize_t(self->count);
+}
+
+static PyObject *
+tree_get_file_count(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->file_count);
+}
+
+static PyObject *
+tree_get_dir_count(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->dir_count);
+}
+
+static PyObject *
+tree_get_error_count(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLongLong(self->error_count);
+}
+
+static PyObject *
+tree_get_root_path(ScanTreeObject *self, void *closure)
+{
+    (void)closure;
+    if (!self->root_path)
+        Py_RETURN_NONE;
+    return Py_NewRef(self->root_path);
+}
+
+static PyGetSetDef ScanTree_getset[] = {
+    {"root", (getter)tree_get_root, NULL, "handle to the root node", NULL},
+    {"node_count", (getter)tree_get_node_count, NULL,
+     "total nodes, including the root", NULL},
+    {"file_count", (getter)tree_get_file_count, NULL,
+     "files discovered during the scan", NULL},
+    {"dir_count", (getter)tree_get_dir_count, NULL,
+     "directories discovered, including the root", NULL},
+    {"error_count", (getter)tree_get_error_count, NULL,
+     "entries skipped due to access errors", NULL},
+    {"root_path", (getter)tree_get_root_path, NULL,
+     "resolved scan root path", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyObject *
+tree_finalize(ScanTreeObject *self, PyObject *Py_UNUSED(ignored))
+{
+    int rc;
+    Py_BEGIN_ALLOW_THREADS
+    rc = tree_finalize_impl(self);
+    Py_END_ALLOW_THREADS
+    if (rc < 0)
+        return PyErr_NoMemory();
+    Py_RETURN_NONE;
+}
+
+/* ------------------------------------------------------------------ */
+/* Per-extension aggregation (one sweep over the flat arrays)         */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Accumulates (count, size_bytes, disk_usage) per lowercased file
+ * extension in a single index pass — no handles, no per-node Python
+ * work.  The map keys point at the extension suffix inside the packed
+ * name heap (basenames are NUL-terminated, so a suffix is a valid C
+ * string); hashing and equality are ASCII-case-insensitive, and the key
+ * is lowercased once when the result dict is built.
+ */
+
+typedef struct {
+    const char *ext;           /* NULL = empty slot */
+    long long count;
+    long long size;
+    long long disk;
+} ExtSlot;
+
+typedef struct {
+    ExtSlot *slots;
+    size_t used;
+    size_t capacity;           /* power of two */
+} ExtMap;
+
+static uint64_t
+ext_hash(const char *s)
+{
+    /* FNV-1a over lowercased bytes. */
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (; *s; s++) {
+        h ^= (uint64_t)tolower((unsigned char)*s);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static int
+ext_equal(const char *a, const char *b)
+{
+    for (; *a && *b; a++, b++) {
+        if (tolower((unsigned char)*a) != tolower((unsigned char)*b))
+            return 0;
+    }
+    return *a == *b;
+}
+
+static int
+ext_map_grow(ExtMap *m)
+{
+    size_t new_cap = m->capacity ? m->capacity * 2 : 64;
+    ExtSlot *nw = (ExtSlot *)calloc(new_cap, sizeof(ExtSlot));
+    if (!nw)
+        return -1;
+    size_t mask = new_cap - 1;
+    for (size_t i = 0; i < m->capacity; i++) {
+        ExtSlot *old = &m->slots[i];
+        if (!old->ext)
+            continue;
+        size_t j = (size_t)ext_hash(old->ext) & mask;
+        while (nw[j].ext)
+            j = (j + 1) & mask;
+        nw[j] = *old;
+    }
+    free(m->slots);
+    m->slots = nw;
+    m->capacity = new_cap;
+    return 0;
+}
+
+static int
+ext_map_add(ExtMap *m, const char *ext, long long size, long long disk)
+{
+    /* Grow at 50% load so linear probing stays short. */
+    if ((m->used + 1) * 2 > m->capacity && ext_map_grow(m) < 0)
+        return -1;
+    size_t mask = m->capacity - 1;
+    size_t i = (size_t)ext_hash(ext) & mask;
+    for (;;) {
+        ExtSlot *slot = &m->slots[i];
+        if (!slot->ext) {
+            slot->ext = ext;
+            slot->count = 1;
+            slot->size = size;
+            slot->disk = disk;
+            m->used++;
+            return 0;
+        }
+        if (ext_equal(slot->ext, ext)) {
+            slot->count++;
+            slot->size += size;
+            slot->disk += disk;
+            return 0;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/* The extension of a basename: the suffix after the last '.', or ""
+ * when there is none.  A leading dot is a hidden file, not an extension
+ * (".bashrc"), and a trailing dot yields nothing either ("name."). */
+static const char *
+name_extension(const char *name)
+{
+    const char *dot = strrchr(name, '.');
+    if (!dot || dot == name || dot[1] == '\0')
+        return "";
+    return dot + 1;
+}
+
+static int
+tree_by_extension_impl(ScanTreeObject *t, ExtMap *m)
+{
+    for (Py_ssize_t i = 0; i < t->count; i++) {
+        if (t->kind[i] != ST_KIND_FILE)
+            continue;
+        const char *ext = name_extension(t->names + t->name_off[i]);
+        if (ext_map_add(m, ext, t->size_bytes[i], t->disk_usage[i]) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+tree_by_extension(ScanTreeObject *self, PyObject *Py_UNUSED(ignored))
+{
+    ExtMap map = {NULL, 0, 0};
+    int rc;
+
+    Py_BEGIN_ALLOW_THREADS
+    rc = tree_by_extension_impl(self, &map);
+    Py_END_ALLOW_THREADS
+
+    if (rc < 0) {
+        free(map.slots);
+        return PyErr_NoMemory();
+    }
+
+    PyObject *dict = PyDict_New();
+    if (!dict) {
+        free(map.slots);
+        return NULL;
+    }
+    char small[64];
+    for (size_t i = 0; i < map.capacity; i++) {
+        ExtSlot *slot = &map.slots[i];
+        if (!slot->ext)
+            continue;
+        size_t len = strlen(slot->ext);
+        char *lower = (len < sizeof(small))
+            ? small : (char *)malloc(len + 1);
+        if (!lower) {
+            PyErr_NoMemory();
+            goto error;
+        }
+        for (size_t j = 0; j < len; j++)
+            lower[j] = (char)tolower((unsigned char)slot->ext[j]);
+        lower[len] = '\0';
+        PyObject *value = Py_BuildValue("(LLL)", slot->count, slot->size,
+                                        slot->disk);
+        int set_rc = value
+            ? PyDict_SetItemString(dict, lower, value) : -1;
+        Py_XDECREF(value);
+        if (lower != small)
+            free(lower);
+        if (set_rc < 0)
+            goto error;
+    }
+    free(map.slots);
+    return dict;
+
+error:
+    free(map.slots);
+    Py_DECREF(dict);
+    return NULL;
+}
+
+static PyObject *
+tree_diff(ScanTreeObject *self, PyObject *args)
+{
+    PyObject *old_obj;
+    if (!PyArg_ParseTuple(args, "O!", &ScanTreeType, &old_obj))
+        return NULL;
+    ScanTreeObject *old = (ScanTreeObject *)old_obj;
+
+    int cmp = PyUnicode_Compare(self->root_path, old->root_path);
+    if (cmp == -1 && PyErr_Occurred())
+        return NULL;
+    if (cmp != 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "snapshots cover different root paths");
+        return NULL;
+    }
+    if (self->count == 0 || old->count == 0)
+        return PyList_New(0);
+
+    const char *root_path = PyUnicode_AsUTF8(self->root_path);
+    if (!root_path)
+        return NULL;
+    size_t rlen = strlen(root_path);
+
+    DiffOut out;
+    memset(&out, 0, sizeof(out));
+    DiffAgg agg = {0, 0, 0, 0, 0};
+    int rc;
+
+    Py_BEGIN_ALLOW_THREADS
+    out.cur_cap = rlen + 256;
+    out.cur = (char *)malloc(out.cur_cap);
+    if (!out.cur) {
+        rc = -1;
+    } else {
+        memcpy(out.cur, root_path, rlen + 1);
+        out.cur_len = rlen;
+        rc = diff_dirs(self, 0, old, 0, &out, &agg);
+        /* One summary record for the root itself, covering the whole
+         * tree's delta. */
+        if (rc == 0 && agg.changed)
+            rc = diff_emit(&out, ST_DIFF_CHANGED, 1, agg.dsize, agg.ddisk,
+                           agg.added, agg.removed);
+    }
+    Py_END_ALLOW_THREADS
+
+    PyObject *list = NULL;
+    if (rc < 0) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    list = PyList_New(out.rec_count);
+    if (!list)
+        goto done;
+    for (Py_ssize_t i = 0; i < out.rec_count; i++) {
+        DiffRec *r = &out.recs[i];
+        PyObject *item = Py_BuildValue(
+            "(sOiLLLL)", out.paths + r->path_off,
+            r->is_dir ? Py_True : Py_False, (int)r->status,
+            r->dsize, r->ddisk, r->added, r->removed);
+        if (!item) {
+            Py_CLEAR(list);
+            goto done;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+
+done:
+    free(out.recs);
+    free(out.paths);
+    free(out.cur);
+    return list;
+}
+
+static PyMethodDef ScanTree_methods[] = {
+    {"finalize", (PyCFunction)tree_finalize, METH_NOARGS,
+     "finalize() -> None\n\n"
+     "Sum child sizes into directories bottom-up and sort every\n"
+     "directory's children by disk_usage descending, entirely over the\n"
+     "native arrays with the GIL released.  Idempotent."},
+    {"by_extension", (PyCFunction)tree_by_extension, METH_NOARGS,
+     "by_extension() -> dict[str, tuple[int, int, int]]\n\n"
+     "One sweep over the node arrays accumulating per lowercased file\n"
+     "extension ('' for files without one): extension -> (count,\n"
+     "size_bytes, disk_usage).  The sweep runs with the GIL released;\n"
+     "only the small result dict touches the interpreter."},
+    {"scan", (PyCFunction)tree_scan,
+     METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+     "scan(path, kind_dir, kind_file, max_depth=-1, prior=None) -> ScanTree\n\n"
+     "Walk the filesystem below path into struct-of-arrays storage with\n"
+     "the GIL released.  Directories deeper than max_depth stay as empty\n"
+     "boundary nodes (max_depth=-1 means unlimited).  With prior (a\n"
+     "ScanTree of the same root), subdirectories whose mtime is unchanged\n"
+     "are grafted from the prior tree instead of being walked."},
+    {"save", (PyCFunction)tree_save, METH_VARARGS,
+     "save(path) -> None\n\n"
+     "Write the tree as a flat binary snapshot (fixed-width node records\n"
+     "plus a string table) suitable for mmap loading.  GIL released for\n"
+     "the whole write."},
+    {"diff", (PyCFunction)tree_diff, METH_VARARGS,
+     "diff(old) -> list[tuple]\n\n"
+     "Merged traversal against an older ScanTree of the same root.\n"
+     "Returns (path, is_dir, status, delta_size, delta_disk,\n"
+     "nodes_added, nodes_removed) tuples: one per added/removed subtree\n"
+     "or changed file, plus one CHANGED record per directory whose\n"
+     "subtree differs (growth attribution).  Status values are the\n"
+     "module's DIFF_CHANGED/DIFF_ADDED/DIFF_REMOVED constants.  GIL\n"
+     "released for the whole merge."},
+    {"load", (PyCFunction)tree_load, METH_VARARGS | METH_CLASS,
+     "load(path, kind_dir, kind_file) -> ScanTree\n\n"
+     "Memory-map a snapshot written by save().  The arrays are served\n"
+     "directly from the (copy-on-write) mapping — nothing is parsed or\n"
+     "deserialized, so loading is page-cache-fault fast."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject ScanTreeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "dux._scan_tree.ScanTree",
+    .tp_basicsize = sizeof(ScanTreeObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Struct-of-arrays scan result tree.  Create via ScanTree.scan().",
+    .tp_dealloc = (destructor)tree_dealloc,
+    .tp_methods = ScanTree_methods,
+    .tp_getset = ScanTree_getset,
+};
+
+/* ------------------------------------------------------------------ */
+/* Module definition (multi-phase init for free-threaded compat)      */
+/* ------------------------------------------------------------------ */
+
+static int
+scan_tree_exec(PyObject *m)
+{
+    if (PyType_Ready(&ScanTreeType) < 0)
+        return -1;
+    if (PyType_Ready(&ScanTreeNodeType) < 0)
+        return -1;
+    if (PyModule_AddObjectRef(m, "ScanTree", (PyObject *)&ScanTreeType) < 0)
+        return -1;
+    if (PyModule_AddObjectRef(m, "ScanTreeNode",
+                              (PyObject *)&ScanTreeNodeType) < 0)
+        return -1;
+    if (PyModule_AddIntConstant(m, "DIFF_CHANGED", ST_DIFF_CHANGED) < 0
+        || PyModule_AddIntConstant(m, "DIFF_ADDED", ST_DIFF_ADDED) < 0
+        || PyModule_AddIntConstant(m, "DIFF_REMOVED", ST_DIFF_REMOVED) < 0)
+        return -1;
+    return 0;
+}
+
+/* Thread-safety contract: the arrays are written only inside scan()
+ * (single call, GIL released around pure C code touching no Python
+ * state) and by the size_bytes/disk_usage setters.  Concurrent readers
+ * are safe; concurrent writers are the caller's responsibility, same as
+ * for ScanNode fields.  This justifies Py_MOD_GIL_NOT_USED. */
+static PyModuleDef_Slot scan_tree_slots[] = {
+    {Py_mod_exec, scan_tree_exec},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
+};
+
+static struct PyModuleDef scan_tree_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "dux._scan_tree",
+    .m_doc = "Struct-of-arrays scan tree with lazy node handles.",
+    .m_size = 0,
+    .m_slots = scan_tree_slots,
+};
+
+PyMODINIT_FUNC
+PyInit__scan_tree(void)
+{
+    return PyModuleDef_Init(&scan_tree_module);
+}
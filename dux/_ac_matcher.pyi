@@ -4,3 +4,4 @@ class AhoCorasick:
     def add_word(self, key: str, value: Any) -> None: ...
     def make_automaton(self) -> None: ...
     def iter(self, text: str) -> list[tuple[int, Any]]: ...
+    def iter_many(self, paths: list[str]) -> list[tuple[int, list[tuple[int, Any]]]]: ...
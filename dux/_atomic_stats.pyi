@@ -0,0 +1,4 @@
+class AtomicStats:
+    def __init__(self) -> None: ...
+    def add(self, files: int, dirs: int, errors: int) -> None: ...
+    def snapshot(self) -> tuple[int, int, int]: ...
@@ -0,0 +1,8 @@
+OVERFLOW: int
+
+class Watcher:
+    def add(self, path: str) -> int: ...
+    def remove(self, wd: int) -> None: ...
+    def poll(self, timeout_ms: int = 0) -> list[int]: ...
+    def fileno(self) -> int: ...
+    def close(self) -> None: ...
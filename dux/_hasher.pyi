@@ -0,0 +1,4 @@
+SAMPLE_SPAN: int
+
+def hash_sampled(paths: list[str]) -> list[int | None]: ...
+def hash_full(paths: list[str]) -> list[int | None]: ...
@@ -0,0 +1,14 @@
+from typing import Any
+
+class CompiledRuleSetNative:
+    def add_exact(self, kind: int, key: str, rule: Any, category: int) -> None: ...
+    def add_substring(self, kind: int, key: str, rule: Any, category: int, end_only: bool) -> None: ...
+    def add_prefix(self, kind: int, key: str, rule: Any, category: int) -> None: ...
+    def add_glob(self, kind: int, pattern: str, rule: Any, category: int) -> None: ...
+    def add_path(self, kind: int, base: str, rule: Any, category: int) -> None: ...
+    def build(self) -> None: ...
+    def match(self, path: str, basename: str, is_dir: bool) -> list[Any]: ...
+    def match_many(self, items: list[tuple[str, str, bool]]) -> list[list[Any]]: ...
+    def save(self, path: str) -> None: ...
+    @classmethod
+    def load(cls, path: str, rules: list[Any]) -> CompiledRuleSetNative: ...
@@ -0,0 +1,47 @@
+from dux.models.enums import NodeKind
+
+DIFF_CHANGED: int
+DIFF_ADDED: int
+DIFF_REMOVED: int
+
+class ScanTreeNode:
+    name: str
+    path: str
+    kind: NodeKind
+    is_dir: bool
+    size_bytes: int
+    disk_usage: int
+    children: list[ScanTreeNode]
+    parent: ScanTreeNode | None
+    index: int
+    mtime_ns: int
+    tree: ScanTree
+
+class ScanTree:
+    root: ScanTreeNode
+    node_count: int
+    file_count: int
+    dir_count: int
+    error_count: int
+    root_path: str
+
+    def finalize(self) -> None: ...
+    def by_extension(self) -> dict[str, tuple[int, int, int]]: ...
+    def diff(self, old: ScanTree) -> list[tuple[str, bool, int, int, int, int, int]]: ...
+    def save(self, path: str) -> None: ...
+    @classmethod
+    def load(
+        cls,
+        path: str,
+        kind_dir: NodeKind,
+        kind_file: NodeKind,
+    ) -> ScanTree: ...
+    @classmethod
+    def scan(
+        cls,
+        path: str,
+        kind_dir: NodeKind,
+        kind_file: NodeKind,
+        max_depth: int = -1,
+        prior: ScanTree | None = None,
+    ) -> ScanTree: ...
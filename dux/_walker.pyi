@@ -1,6 +1,18 @@
 from dux.models.enums import NodeKind
 from dux.models.scan import ScanNode
 
+class InodeSet:
+    def add(self, dev: int, ino: int) -> bool: ...
+    def __len__(self) -> int: ...
+
+class TopN:
+    def __init__(self, capacity: int) -> None: ...
+    def push(self, key: int, item: ScanNode) -> bool: ...
+    def result(self) -> list[ScanNode]: ...
+    def __len__(self) -> int: ...
+
+def prof_enable(on: bool) -> None: ...
+def prof_snapshot() -> dict[str, int]: ...
 def scan_dir_nodes(
     path: str,
     parent: ScanNode,
@@ -8,6 +20,22 @@ def scan_dir_nodes(
     kind_dir: NodeKind,
     kind_file: NodeKind,
     scan_node_cls: type[ScanNode],
+    inode_set: InodeSet | None = None,
+    root_dev: int = 0,
+    top_files: TopN | None = None,
+) -> tuple[list[ScanNode], int, int, int]: ...
+def scan_tree_nodes(
+    path: str,
+    parent: ScanNode,
+    leaf: tuple[()],
+    kind_dir: NodeKind,
+    kind_file: NodeKind,
+    scan_node_cls: type[ScanNode],
+    max_levels: int,
+    emit_frontier: bool,
+    inode_set: InodeSet | None = None,
+    root_dev: int = 0,
+    top_files: TopN | None = None,
 ) -> tuple[list[ScanNode], int, int, int]: ...
 def scan_dir_bulk_nodes(
     path: str,
@@ -16,4 +44,29 @@ def scan_dir_bulk_nodes(
     kind_dir: NodeKind,
     kind_file: NodeKind,
     scan_node_cls: type[ScanNode],
+    inode_set: InodeSet | None = None,
+    root_dev: int = 0,
+    top_files: TopN | None = None,
+) -> tuple[list[ScanNode], int, int, int]: ...
+def scan_dir_statx_nodes(
+    path: str,
+    parent: ScanNode,
+    leaf: tuple[()],
+    kind_dir: NodeKind,
+    kind_file: NodeKind,
+    scan_node_cls: type[ScanNode],
+    inode_set: InodeSet | None = None,
+    root_dev: int = 0,
+    top_files: TopN | None = None,
+) -> tuple[list[ScanNode], int, int, int]: ...
+def scan_dir_uring_nodes(
+    path: str,
+    parent: ScanNode,
+    leaf: tuple[()],
+    kind_dir: NodeKind,
+    kind_file: NodeKind,
+    scan_node_cls: type[ScanNode],
+    inode_set: InodeSet | None = None,
+    root_dev: int = 0,
+    top_files: TopN | None = None,
 ) -> tuple[list[ScanNode], int, int, int]: ...
@@ -21,9 +21,15 @@ from dux.config.loader import load_config, sample_config_json
 from dux.config.schema import clamp_field
 from dux.models.scan import ScanError, ScanErrorCode, ScanOptions, ScanResult
 from dux.scan import Scanner, create_scanner
-from dux.services.insights import generate_insights
-from dux.services.summary import render_focused_summary, render_summary
+from dux.services.diff import diff_snapshots
+from dux.services.duplicates import DEFAULT_MIN_SIZE, find_duplicates
+from dux.services.insights import generate_insights, merge_duplicate_insights
+from dux.services.patterns import prune_dir_basenames
+from dux.services.snapshot_io import load_snapshot, save_snapshot
+from dux.services.summary import render_diff, render_duplicates, render_focused_summary, render_summary
+from dux.services.watch import WatchService
 from dux.ui.app import DuxApp
+from dux.ui.diff_app import DiffApp
 
 console = Console()
 
@@ -140,7 +146,12 @@ def run(
     top_cache: Annotated[bool, typer.Option("--top-cache", "-c", help="Show largest cache files/directories.")] = False,
     top_dirs: Annotated[bool, typer.Option("--top-dirs", "-d", help="Show largest directories.")] = False,
     top_files: Annotated[bool, typer.Option("--top-files", "-f", help="Show largest files.")] = False,
+    by_ext: Annotated[bool, typer.Option("--by-ext", "-e", help="Show disk usage by file extension.")] = False,
     interactive: Annotated[bool, typer.Option("--interactive", "-i", help="Launch interactive TUI.")] = False,
+    watch: Annotated[
+        bool,
+        typer.Option("--watch", help="With --interactive: keep the TUI updated from filesystem events (Linux)."),
+    ] = False,
     sample_config: Annotated[bool, typer.Option("--sample-config", help="Print sample config JSON.")] = False,
     max_depth: Annotated[int | None, typer.Option("--max-depth", help="Max directory depth to scan.")] = None,
     workers: Annotated[int | None, typer.Option("--workers", "-w", help="Number of scan workers.")] = None,
@@ -155,9 +166,60 @@ def run(
     apparent_size: Annotated[
         bool, typer.Option("--apparent-size", "-A", help="Show apparent size column (logical file size).")
     ] = False,
+    dedup_hardlinks: Annotated[
+        bool,
+        typer.Option("--dedup-hardlinks", "-H", help="Count hardlinked files once per inode, like du."),
+    ] = False,
+    one_filesystem: Annotated[
+        bool,
+        typer.Option("--one-filesystem", "-x", help="Stay on the root's filesystem; skip mount points, like du -x."),
+    ] = False,
+    prune: Annotated[
+        bool,
+        typer.Option(
+            "--prune",
+            help="Skip subtrees matched by stop-recursion rules (node_modules, .venv, ...) during the scan. "
+            "Pruned dirs appear in the tree but report no size.",
+        ),
+    ] = False,
+    sample_depth: Annotated[
+        int | None,
+        typer.Option(
+            "--sample-depth",
+            help="Estimation mode: scan fully to this depth, then sample a fraction of "
+            "subdirectories below it and extrapolate (fast ± answer on huge volumes).",
+        ),
+    ] = None,
+    sample_fraction: Annotated[
+        float,
+        typer.Option("--sample-fraction", help="Fraction of subdirectories sampled below --sample-depth."),
+    ] = 0.1,
     scanner: Annotated[
-        str, typer.Option("--scanner", "-S", help="Scanner variant: auto, python, posix, macos.")
+        str,
+        typer.Option(
+            "--scanner", "-S", help="Scanner variant: auto, python, posix, tree, compact, linux, uring, macos, nogil."
+        ),
     ] = "auto",
+    snapshot_out: Annotated[
+        str | None,
+        typer.Option("--save-snapshot", help="Write a binary snapshot after scanning (requires --scanner compact)."),
+    ] = None,
+    dupes: Annotated[
+        bool,
+        typer.Option(
+            "--dupes",
+            "-D",
+            help="Find duplicate files: size-bucketed candidates from the scan, confirmed by content hashing.",
+        ),
+    ] = False,
+    dupes_min_size: Annotated[
+        int,
+        typer.Option("--dupes-min-size", help="Ignore files smaller than this many bytes in --dupes."),
+    ] = DEFAULT_MIN_SIZE,
+    prof: Annotated[
+        bool,
+        typer.Option("--prof", help="Collect hot-path timing/counter stats during the scan and report them."),
+    ] = False,
     verbose: Annotated[
         bool, typer.Option("--verbose", "-v", help="Print GIL status, scanner, and timing info.")
     ] = False,
@@ -194,8 +256,46 @@ def run(
     if overrides:
         config = replace(config, **overrides)
 
+    if dedup_hardlinks and scanner == "compact":
+        console.print("[yellow]--dedup-hardlinks is not supported by the compact scanner; ignoring.[/]")
+        dedup_hardlinks = False
+    if one_filesystem and scanner == "compact":
+        console.print("[yellow]--one-filesystem is not supported by the compact scanner; ignoring.[/]")
+        one_filesystem = False
+    if prune and scanner == "compact":
+        console.print("[yellow]--prune is not supported by the compact scanner; ignoring.[/]")
+        prune = False
+    if sample_depth is not None and scanner == "compact":
+        console.print("[yellow]--sample-depth is not supported by the compact scanner; ignoring.[/]")
+        sample_depth = None
+    if watch and not interactive:
+        console.print("[yellow]--watch requires --interactive; ignoring.[/]")
+        watch = False
+    if dupes and scanner == "compact":
+        # Candidate collection walks ScanNode children; the compact tree
+        # would need its own traversal.
+        console.print("[yellow]--dupes is not supported by the compact scanner; ignoring.[/]")
+        dupes = False
+    if watch and scanner == "compact":
+        # The compact tree is backed by flat C arrays; incremental
+        # patching needs the mutable ScanNode tree.
+        console.print("[yellow]--watch is not supported by the compact scanner; ignoring.[/]")
+        watch = False
+
     scan_options = ScanOptions(
         max_depth=config.max_depth,
+        dedup_hardlinks=dedup_hardlinks,
+        one_filesystem=one_filesystem,
+        prune_dirs=prune_dir_basenames(config.patterns) if prune else None,
+        # Streaming top-N costs O(1) per file, so collect whenever a
+        # largest-nodes table will be rendered.  The compact scanner
+        # ignores this and the summary falls back to tree traversal.
+        top_n=config.top_count if (top_dirs or top_files) and not interactive else 0,
+        sample_depth=sample_depth,
+        sample_fraction=min(1.0, max(0.01, sample_fraction)),
+        # The compact scanner never enters the instrumented base class;
+        # its profile would be empty rather than wrong, so no guard.
+        profile=prof and scanner != "compact",
     )
 
     scanner_impl: Scanner
@@ -219,30 +319,80 @@ def run(
     snapshot = scan_result.unwrap()
     scan_elapsed = time.perf_counter() - t0
 
+    if snapshot_out is not None:
+        try:
+            save_snapshot(snapshot, snapshot_out)
+        except (TypeError, OSError) as exc:
+            console.print(f"[red]{escape(str(exc))}[/]")
+            raise typer.Exit(1) from exc
+        if verbose:
+            console.print(f"[#969896]Snapshot written to {escape(snapshot_out)}[/]")
+
     t1 = time.perf_counter()
     with console.status("[bold #8abeb7]Generating insights...[/]"):
         bundle = generate_insights(snapshot.root, config)
     insight_elapsed = time.perf_counter() - t1
 
+    dupe_groups = None
+    if dupes:
+        with console.status("[bold #8abeb7]Confirming duplicates...[/]"):
+            dupe_groups = find_duplicates(
+                snapshot.root,
+                min_size=max(1, dupes_min_size),
+                workers=config.scan_workers,
+            )
+        bundle = merge_duplicate_insights(bundle, dupe_groups, config.max_insights_per_category)
+
     if verbose:
         stats = snapshot.stats
         msg = f"[#969896]Scan: {scan_elapsed:.2f}s | Insights: {insight_elapsed:.2f}s | {stats.files:,} files, {stats.directories:,} dirs[/]"
         console.print(msg)
 
+    if snapshot.stats.profile is not None and not interactive:
+        p = snapshot.stats.profile
+        console.print(
+            f"[#969896]prof: wall {p['wall_s']:.2f}s ({p['entries_per_s']:,.0f} entries/s) | "
+            f"walker io {p['walker_io_s']:.2f}s, gil wait {p['walker_gil_wait_s']:.2f}s, "
+            f"build {p['walker_build_s']:.2f}s over {p['walker_calls']:,.0f} calls | "
+            f"queue {p['queue_steals']:,.0f} steals, {p['queue_parks']:,.0f} parks "
+            f"({p['queue_park_s']:.2f}s) | finalize {p['finalize_s']:.2f}s[/]"
+        )
+
     if interactive:
-        DuxApp(
-            root=snapshot.root,
-            stats=snapshot.stats,
-            bundle=bundle,
-            config=config,
-            apparent_size=apparent_size,
-        ).run()
+        watcher = None
+        if watch:
+            try:
+                watcher = WatchService(snapshot.root, snapshot.stats, prune_dirs=scan_options.prune_dirs)
+            except OSError as exc:
+                console.print(f"[yellow]Watch mode unavailable: {exc}[/]")
+        try:
+            DuxApp(
+                root=snapshot.root,
+                stats=snapshot.stats,
+                bundle=bundle,
+                config=config,
+                apparent_size=apparent_size,
+                watch=watcher,
+            ).run()
+        finally:
+            if watcher is not None:
+                watcher.close()
         raise typer.Exit(0)
 
     root_prefix = snapshot.root.path.rstrip("/") + "/"
+    if dupe_groups is not None:
+        render_duplicates(console, dupe_groups, config.top_count, root_prefix)
     if snapshot.stats.access_errors:
         console.print(f"[red]{snapshot.stats.access_errors:,} access errors during scan[/red]")
-    render_summary(console, snapshot.root, snapshot.stats, root_prefix, apparent_size=apparent_size)
+    render_summary(
+        console,
+        snapshot.root,
+        snapshot.stats,
+        root_prefix,
+        apparent_size=apparent_size,
+        size_margin=snapshot.size_margin,
+        disk_margin=snapshot.disk_margin,
+    )
     render_focused_summary(
         console,
         snapshot.root,
@@ -253,12 +403,48 @@ def run(
         top_cache=top_cache,
         top_dirs=top_dirs,
         top_files=top_files,
+        by_ext=by_ext,
+        top_dir_nodes=snapshot.top_dirs,
+        top_file_nodes=snapshot.top_files,
         apparent_size=apparent_size,
     )
 
 
+def diff(
+    old: Annotated[str, typer.Argument(help="Older snapshot file (written by --save-snapshot).")],
+    new: Annotated[str, typer.Argument(help="Newer snapshot file.")],
+    top: Annotated[int, typer.Option("--top", help="Number of movers to show.")] = 30,
+    interactive: Annotated[bool, typer.Option("--interactive", "-i", help="Browse the diff in a TUI.")] = False,
+) -> None:
+    """Show what grew or shrank between two saved snapshots."""
+    try:
+        old_snap = load_snapshot(old)
+        new_snap = load_snapshot(new)
+        entries = diff_snapshots(old_snap, new_snap)
+    except (OSError, ValueError) as exc:
+        console.print(f"[red]{escape(str(exc))}[/]")
+        raise typer.Exit(1) from exc
+
+    if not entries:
+        console.print("[#b5bd68]No differences between the two snapshots.[/]")
+        raise typer.Exit(0)
+
+    root_prefix = new_snap.root.path.rstrip("/") + "/"
+    if interactive:
+        DiffApp(entries, root_prefix).run()
+        raise typer.Exit(0)
+    render_diff(console, entries, top, root_prefix)
+
+
 def cli() -> None:
-    typer.run(run)
+    # typer.run() exposes a single command; dispatching on argv[1] keeps
+    # the common `dux <path>` form working unchanged while still giving
+    # `dux diff OLD NEW` its own flags and help text.
+    if len(sys.argv) > 1 and sys.argv[1] == "diff":
+        sys.argv = [f"{sys.argv[0]} diff", *sys.argv[2:]]
+        typer.run(diff)
+    else:
+        typer.run(run)
 
 
 if __name__ == "__main__":
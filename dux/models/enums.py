@@ -9,10 +9,21 @@ class NodeKind(str, Enum):
     DIRECTORY = "directory"
 
 
+class DiffStatus(str, Enum):
+    """How a path differs between two snapshots (see services/diff.py)."""
+
+    CHANGED = "changed"
+    ADDED = "added"
+    REMOVED = "removed"
+
+
 class InsightCategory(str, Enum):
     TEMP = "temp"
     CACHE = "cache"
     BUILD_ARTIFACT = "build_artifact"
+    # Populated by the dedup engine (services/duplicates.py), not by
+    # pattern rules.
+    DUPLICATE = "duplicate"
 
     @property
     def label(self) -> str:
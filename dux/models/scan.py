@@ -15,40 +15,80 @@ CancelCheck = Callable[[], bool]
 
 @dataclass(slots=True)
 class ScanNode:
-    path: str
+    """One filesystem entry in the scan tree.
+
+    Nodes store only their basename plus a parent reference; the absolute
+    path is joined on demand by the ``path`` property.  In a deep tree this
+    avoids holding every directory prefix once per descendant — the
+    duplicated prefixes dominate string memory on large scans.  A node with
+    no parent (the scan root, or a detached node) stores its full path in
+    ``name``.
+
+    ``parent`` is excluded from repr and comparison: the parent/children
+    back-references form reference cycles (collected by gc), and including
+    them would make both operations recurse forever.
+    """
+
     name: str
     kind: NodeKind
     size_bytes: int
     disk_usage: int
     children: list[ScanNode] = field(default_factory=list)
+    parent: ScanNode | None = field(default=None, repr=False, compare=False)
+    # Directory matched a prune rule during the scan: it stays in the
+    # tree but was never descended into, so its sizes are unknown (0).
+    unexpanded: bool = False
+    # Sizes are extrapolated, not measured: either this directory was
+    # skipped by estimation-mode sampling and assigned the mean of its
+    # scanned siblings, or its subtree contains such a directory.  The
+    # UI renders these distinctly (see ScanOptions.sample_depth).
+    estimated: bool = False
 
     @property
     def is_dir(self) -> bool:
         return self.kind is NodeKind.DIRECTORY
 
+    @property
+    def path(self) -> str:
+        """Absolute path, materialized from the parent chain."""
+        if self.parent is None:
+            return self.name
+        parts: list[str] = []
+        node: ScanNode = self
+        while node.parent is not None:
+            parts.append(node.name)
+            node = node.parent
+        anchor = node.name
+        if anchor.endswith("/"):
+            anchor = anchor[:-1]  # root "/" (or trailing slash) would double up
+        parts.append(anchor)
+        return "/".join(reversed(parts))
+
     @classmethod
-    def file(cls, path: str, name: str, size_bytes: int, disk_usage: int) -> ScanNode:
+    def file(
+        cls, name: str, size_bytes: int, disk_usage: int, parent: ScanNode | None = None
+    ) -> ScanNode:
         # Import here to avoid circular import at module level.
         from dux.services.tree import LEAF_CHILDREN
 
         return cls(
-            path=path,
             name=name,
             kind=NodeKind.FILE,
             size_bytes=size_bytes,
             disk_usage=disk_usage,
             children=LEAF_CHILDREN,  # type: ignore[arg-type]  # immutable sentinel
+            parent=parent,
         )
 
     @classmethod
-    def directory(cls, path: str, name: str) -> ScanNode:
+    def directory(cls, name: str, parent: ScanNode | None = None) -> ScanNode:
         return cls(
-            path=path,
             name=name,
             kind=NodeKind.DIRECTORY,
             size_bytes=0,
             disk_usage=0,
             children=[],
+            parent=parent,
         )
 
 
@@ -57,17 +97,65 @@ class ScanStats:
     files: int = 0
     directories: int = 0
     access_errors: int = 0
+    # Where the scan time went, present only when the scan ran with
+    # ScanOptions.profile: walker I/O / GIL-wait / node-build seconds,
+    # queue steal and park counters, finalize and wall time, entries/sec
+    # (keys documented on ThreadedScannerBase.scan).  Rendered in the
+    # TUI overview and by --verbose.
+    profile: dict[str, float] | None = None
 
 
 @dataclass(slots=True)
 class ScanOptions:
     max_depth: int | None = None
+    # Count hardlinked files once per inode instead of once per path
+    # (du semantics).  Honoured by the ThreadedScannerBase scanners;
+    # the compact (ScanTree) scanner does not support it.
+    dedup_hardlinks: bool = False
+    # Stay on the root's filesystem, like du -x: directories on another
+    # st_dev are kept as empty mount-point leaves and never descended
+    # into.  Same scanner support as dedup_hardlinks.
+    one_filesystem: bool = False
+    # Lowercased directory basenames to prune: matching dirs are kept as
+    # unexpanded leaf nodes and their subtrees are never walked.  Built
+    # from stop_recursion rules via patterns.prune_dir_basenames.
+    prune_dirs: frozenset[str] | None = None
+    # When > 0, collect the N largest files and directories during the
+    # scan (streaming, bounded min-heaps) and attach them to the
+    # snapshot, sparing the summary a full-tree re-traversal.  Same
+    # scanner support as dedup_hardlinks; consumers fall back to
+    # tree.top_nodes when the snapshot carries no lists.
+    top_n: int = 0
+    # Estimation mode for volumes too large to enumerate: descend fully
+    # to this depth, then below it scan only sample_fraction of each
+    # directory's subdirectories and extrapolate the rest from the
+    # sampled siblings (tree.extrapolate_estimates).  Extrapolated nodes
+    # carry ScanNode.estimated and the snapshot carries a ± margin for
+    # the root totals.  Same scanner support as dedup_hardlinks.
+    sample_depth: int | None = None
+    sample_fraction: float = 0.1
+    # Opt-in hot-path instrumentation (--prof): C walker timing
+    # accumulators plus scheduler counters, surfaced as ScanStats.profile.
+    # Near-zero cost when off — one branch per C call, nothing else.
+    profile: bool = False
 
 
 @dataclass(slots=True, frozen=True)
 class ScanSnapshot:
     root: ScanNode
     stats: ScanStats
+    # Pre-collected largest nodes (disk_usage descending), present only
+    # when the scan ran with options.top_n set; None means "not
+    # collected", and readers should traverse the tree instead.
+    top_files: list[ScanNode] | None = None
+    top_dirs: list[ScanNode] | None = None
+    # Half-width of the ~95% confidence interval on the root totals,
+    # present only when the scan ran with options.sample_depth set.
+    # Zero when every sample within a directory agreed (or with samples
+    # of one, where no spread is observable) — treat small-sample
+    # margins as optimistic.
+    size_margin: int | None = None
+    disk_margin: int | None = None
 
 
 class ScanErrorCode(str, Enum):
@@ -18,35 +18,46 @@ class Scanner(Protocol):
     ) -> ScanResult: ...
 
 
-def default_scanner(workers: int = 4) -> ThreadedScannerBase:
-    """Return the best available scanner for the current platform.
-
-    macOS → NativeScanner (getattrlistbulk).
-    GIL enabled → NativeScanner (C readdir, benefits from GIL release during I/O).
-    GIL disabled → PythonScanner (true parallelism makes the C overhead negligible).
-    """
+def _best_scan_fn():  # noqa: ANN202 — platform-dependent C function
+    """The fastest single-directory C walker for this platform."""
     if sys.platform == "darwin":
         from dux._walker import scan_dir_bulk_nodes
 
-        from dux.scan.native_scanner import NativeScanner
+        return scan_dir_bulk_nodes
+    if sys.platform.startswith("linux"):
+        from dux._walker import scan_dir_statx_nodes
 
-        return NativeScanner(scan_dir_bulk_nodes, workers=workers)
+        return scan_dir_statx_nodes
+    from dux._walker import scan_dir_nodes
 
-    if sys._is_gil_enabled():  # pyright: ignore[reportPrivateUsage]
-        from dux._walker import scan_dir_nodes
+    return scan_dir_nodes
 
-        from dux.scan.native_scanner import NativeScanner
 
-        return NativeScanner(scan_dir_nodes, workers=workers)
+def default_scanner(workers: int = 4) -> Scanner:
+    """Return the best available scanner for the current platform.
+
+    GIL disabled → ShardedScanner over the platform's best C walker
+    (workers own whole subtrees; node construction runs truly in parallel).
+    macOS → NativeScanner (getattrlistbulk).
+    Linux → NativeScanner (getdents64 + statx bulk enumeration).
+    Otherwise → NativeScanner (C readdir, benefits from GIL release during I/O).
+    """
+    if not sys._is_gil_enabled():  # pyright: ignore[reportPrivateUsage]
+        from dux.scan.sharded_scanner import ShardedScanner
+
+        return ShardedScanner(_best_scan_fn(), workers=workers)
+
+    from dux.scan.native_scanner import NativeScanner
 
-    return PythonScanner(workers=workers)
+    return NativeScanner(_best_scan_fn(), workers=workers)
 
 
-def create_scanner(name: str, workers: int = 4) -> ThreadedScannerBase:
+def create_scanner(name: str, workers: int = 4) -> Scanner:
     """Create a scanner by name.
 
-    Valid names: ``auto``, ``python``, ``posix``, ``macos``.
-    Raises ``ValueError`` for unknown names.
+    Valid names: ``auto``, ``python``, ``posix``, ``tree``, ``compact``,
+    ``linux``, ``uring``, ``macos``, ``nogil``.  Raises ``ValueError``
+    for unknown names.
     """
     if name == "auto":
         return default_scanner(workers=workers)
@@ -58,13 +69,37 @@ def create_scanner(name: str, workers: int = 4) -> ThreadedScannerBase:
         from dux.scan.native_scanner import NativeScanner
 
         return NativeScanner(scan_dir_nodes, workers=workers)
+    if name == "tree":
+        from dux.scan.native_scanner import NativeTreeScanner
+
+        return NativeTreeScanner(workers=workers)
+    if name == "compact":
+        from dux.scan.scan_tree_scanner import ScanTreeScanner
+
+        return ScanTreeScanner(workers=workers)
+    if name == "linux":
+        from dux._walker import scan_dir_statx_nodes
+
+        from dux.scan.native_scanner import NativeScanner
+
+        return NativeScanner(scan_dir_statx_nodes, workers=workers)
+    if name == "uring":
+        from dux._walker import scan_dir_uring_nodes
+
+        from dux.scan.native_scanner import NativeScanner
+
+        return NativeScanner(scan_dir_uring_nodes, workers=workers)
     if name == "macos":
         from dux._walker import scan_dir_bulk_nodes
 
         from dux.scan.native_scanner import NativeScanner
 
         return NativeScanner(scan_dir_bulk_nodes, workers=workers)
-    msg = f"Unknown scanner: {name}. Use: auto, python, posix, macos."
+    if name == "nogil":
+        from dux.scan.sharded_scanner import ShardedScanner
+
+        return ShardedScanner(_best_scan_fn(), workers=workers)
+    msg = f"Unknown scanner: {name}. Use: auto, python, posix, tree, compact, linux, uring, macos, nogil."
     raise ValueError(msg)
 
 
@@ -10,8 +10,9 @@
 #   The scan tree is built concurrently, but each directory node is processed
 #   by exactly one worker (guaranteed by the work queue).  Workers append
 #   children to parent.children — since each parent is dequeued by one worker,
-#   there is no concurrent mutation of the same list.  The shared ScanStats
-#   counters are protected by stats_lock via local batching (see run_worker).
+#   there is no concurrent mutation of the same list.  Shared statistics live
+#   in an AtomicStats object (C11 atomics): workers batch locally and flush
+#   with a lock-free add, and progress reads are wait-free (see run_worker).
 #
 # Lifecycle (scan method):
 #   1. Validate root path → create root ScanNode → enqueue it.
@@ -24,12 +25,17 @@ from __future__ import annotations
 
 import collections
 import collections.abc
+import math
+import random
 import threading
+import time
 from abc import ABC, abstractmethod
 from dataclasses import dataclass
 
 from result import Err, Ok
 
+from dux._atomic_stats import AtomicStats
+from dux._walker import InodeSet, TopN, prof_enable, prof_snapshot
 from dux.models.scan import (
     CancelCheck,
     ProgressCallback,
@@ -42,7 +48,7 @@ from dux.models.scan import (
     ScanStats,
 )
 from dux.services.fs import DEFAULT_FS, FileSystem
-from dux.services.tree import finalize_sizes
+from dux.services.tree import extrapolate_estimates, finalize_sizes_parallel
 
 
 @dataclass(slots=True, frozen=True)
@@ -53,19 +59,43 @@ class _Task:
     depth: int
 
 
-class _WorkQueue:
-    """Lightweight work queue with a single lock.
-
-    stdlib queue.Queue uses three Conditions (not_empty, not_full, all_tasks_done),
-    each wrapping its own lock.  This queue is unbounded (no not_full) and uses a
-    simple Event for completion (no all_tasks_done Condition), cutting lock
-    contention in half for the producer-heavy scan workload.
+class _WorkStealingQueue:
+    """Per-worker deques with work stealing.
+
+    The previous single-deque design funneled every put/get through one
+    lock; at 16+ workers on fast storage, workers serialized on that lock
+    rather than on I/O.  Here each worker owns a deque: it pushes
+    discovered directories and pops locally with no lock at all
+    (collections.deque is C-implemented and thread-safe at both ends),
+    and only steals from a victim when its own deque runs dry.  Owners
+    pop newest-first (keeps the subtree they just read cache-warm);
+    thieves steal oldest-first (grabs the largest remaining subtrees) —
+    the classic work-stealing split.
+
+    The _outstanding/_done completion protocol is preserved, but its lock
+    is now touched once per task lifecycle (put/task_done), never on the
+    pop/steal fast path.  A producer only signals the Condition when a
+    worker is actually parked; the short wait timeout below covers the
+    (benign, rare) race where a parking worker misses that signal.
     """
 
-    __slots__ = ("_deque", "_lock", "_not_empty", "_outstanding", "_done", "_shutdown")
-
-    def __init__(self) -> None:
-        self._deque: collections.deque[_Task] = collections.deque()
+    __slots__ = (
+        "_deques", "_lock", "_not_empty", "_outstanding", "_done", "_shutdown", "_waiters",
+        "_prof", "steals", "parks", "park_seconds",
+    )
+
+    def __init__(self, workers: int, profile: bool = False) -> None:
+        self._deques: list[collections.deque[_Task]] = [
+            collections.deque() for _ in range(workers)
+        ]
+        # Scheduler counters behind ScanOptions.profile.  Incremented
+        # without a lock: with profiling off the fast path pays a single
+        # falsy check, and when on a racing increment occasionally lost
+        # under free threading is fine for diagnostic counters.
+        self._prof = profile
+        self.steals = 0
+        self.parks = 0
+        self.park_seconds = 0.0
         self._lock = threading.Lock()
         # Condition wraps _lock: `with self._not_empty` also acquires _lock.
         self._not_empty = threading.Condition(self._lock)
@@ -74,32 +104,70 @@ class _WorkQueue:
         self._outstanding = 0
         self._done = threading.Event()
         self._shutdown = False
+        self._waiters = 0
 
-    def put(self, task: _Task) -> None:
+    def put(self, task: _Task, worker_id: int = 0) -> None:
+        # Order matters: _outstanding must rise before the task becomes
+        # stealable, or a fast thief could drive it to 0 prematurely.
         with self._lock:
-            self._deque.append(task)
             self._outstanding += 1
-            self._not_empty.notify(1)
-
-    def put_many(self, tasks: collections.abc.Iterable[_Task]) -> None:
+        self._deques[worker_id].append(task)
+        if self._waiters:
+            with self._not_empty:
+                self._not_empty.notify(1)
+
+    def put_many(self, tasks: collections.abc.Iterable[_Task], worker_id: int = 0) -> None:
+        # Materialize first: _outstanding must cover the whole batch before
+        # any of it becomes stealable (see put), and tasks is often a
+        # generator that can't be len()'d.
+        batch = list(tasks)
+        if not batch:
+            return
         with self._lock:
-            # tasks is often a generator (can't len()), so measure the
-            # deque before/after to count how many were added.
-            prev = len(self._deque)
-            self._deque.extend(tasks)
-            added = len(self._deque) - prev
-            self._outstanding += added
-            if added:
-                self._not_empty.notify(added)
-
-    def get(self) -> _Task | None:
-        """Block until a task is available.  Returns None on shutdown (exit sentinel)."""
+            self._outstanding += len(batch)
+        self._deques[worker_id].extend(batch)
+        if self._waiters:
+            with self._not_empty:
+                self._not_empty.notify(len(batch))
+
+    def _try_get(self, worker_id: int) -> _Task | None:
+        try:
+            return self._deques[worker_id].pop()  # own deque: LIFO
+        except IndexError:
+            pass
+        n = len(self._deques)
+        for offset in range(1, n):
+            try:
+                task = self._deques[(worker_id + offset) % n].popleft()  # steal: FIFO
+            except IndexError:
+                continue
+            if self._prof:
+                self.steals += 1
+            return task
+        return None
+
+    def get(self, worker_id: int) -> _Task | None:
+        """Pop locally, else steal; park until work arrives.  None on shutdown."""
+        task = self._try_get(worker_id)
+        if task is not None:
+            return task
         with self._not_empty:
-            while not self._deque:
+            while True:
                 if self._shutdown:
                     return None
-                self._not_empty.wait()
-            return self._deque.popleft()
+                task = self._try_get(worker_id)
+                if task is not None:
+                    return task
+                self._waiters += 1
+                if self._prof:
+                    self.parks += 1
+                    t0 = time.perf_counter()
+                    # Timeout bounds the missed-signal race documented above.
+                    self._not_empty.wait(0.05)
+                    self.park_seconds += time.perf_counter() - t0
+                else:
+                    self._not_empty.wait(0.05)
+                self._waiters -= 1
 
     def task_done(self) -> None:
         with self._lock:
@@ -158,6 +226,16 @@ class ThreadedScannerBase(ABC):
     def __init__(self, workers: int = 4, fs: FileSystem = DEFAULT_FS) -> None:
         self._workers = max(1, workers)
         self._fs = fs
+        # Fresh per scan when options.dedup_hardlinks is set; None
+        # otherwise.  Subclasses consult it in _scan_dir to count each
+        # multi-link inode's bytes exactly once across all workers.
+        self._inode_set: InodeSet | None = None
+        # Root st_dev when options.one_filesystem is set; 0 otherwise.
+        # Subclasses keep foreign-device dirs as mount-point leaves.
+        self._root_dev: int = 0
+        # Streaming largest-files collector when options.top_n is set;
+        # subclasses offer each file node as they create it.
+        self._top_files: TopN | None = None
 
     @abstractmethod
     def _scan_dir(self, parent: ScanNode, path: str) -> tuple[list[ScanNode], int, int, int]:
@@ -178,14 +256,39 @@ class ThreadedScannerBase(ABC):
             return Err(resolved)
         resolved_root = resolved
 
-        root_name = resolved_root.rsplit("/", 1)[-1] or resolved_root
-        root_node = ScanNode.directory(resolved_root, root_name)
+        # Hardlink dedup state is per scan: a stale set would make a
+        # second scan of the same tree report every multi-link file as 0.
+        self._inode_set = InodeSet() if options.dedup_hardlinks else None
+        # resolve_root just stat'ed this path successfully, so the stat
+        # here only fails in a race; treat that as "no boundary check".
+        self._root_dev = 0
+        if options.one_filesystem:
+            try:
+                self._root_dev = self._fs.stat(resolved_root).dev
+            except OSError:
+                pass
+        # Fresh collectors per scan for the same staleness reason as the
+        # inode set.  The dirs heap gets one extra slot because finalize
+        # offers the root too, which top_nodes semantics exclude.
+        self._top_files = TopN(options.top_n) if options.top_n else None
+        top_dirs = TopN(options.top_n + 1) if options.top_n else None
+
+        # Parentless nodes hold their full path in ``name`` (the anchor for
+        # every descendant's lazily-joined ``path``).
+        root_node = ScanNode.directory(resolved_root)
+
+        # Profiling brackets the whole scan: the C walker accumulators
+        # are reset here and read (and switched back off) after finalize.
+        scan_t0 = time.perf_counter()
+        if options.profile:
+            prof_enable(True)
 
-        q = _WorkQueue()
+        num_workers = self._workers
+        q = _WorkStealingQueue(num_workers, profile=options.profile)
         q.put(_Task(root_node, 0))
 
-        stats = ScanStats(files=0, directories=1, access_errors=0)
-        stats_lock = threading.Lock()
+        counters = AtomicStats()
+        counters.add(0, 1, 0)  # the root directory itself
         cancelled = threading.Event()
 
         def _is_cancelled() -> bool:
@@ -203,15 +306,13 @@ class ThreadedScannerBase(ABC):
             """Report approximate totals: flushed global stats + unflushed local counts."""
             if progress_callback is None:
                 return
-            with stats_lock:
-                f = stats.files + local_files
-                d = stats.directories + local_dirs
-            progress_callback(current_path, f, d)
-
-        def run_worker() -> None:
-            # Workers batch stat updates locally and flush under the shared lock
-            # once per directory (in the finally block).  This reduces lock
-            # contention from once-per-file to once-per-directory.
+            f, d, _ = counters.snapshot()  # wait-free: never stalls workers
+            progress_callback(current_path, f + local_files, d + local_dirs)
+
+        def run_worker(worker_id: int) -> None:
+            # Workers batch stat updates locally and flush once per directory
+            # (in the finally block).  The flush itself is a lock-free atomic
+            # add, so batching here only amortizes the C-call overhead.
             local_files = 0
             local_dirs = 0
             local_errors = 0
@@ -219,14 +320,11 @@ class ThreadedScannerBase(ABC):
             def _flush_local() -> None:
                 nonlocal local_files, local_dirs, local_errors
                 if local_files or local_dirs or local_errors:
-                    with stats_lock:
-                        stats.files += local_files
-                        stats.directories += local_dirs
-                        stats.access_errors += local_errors
+                    counters.add(local_files, local_dirs, local_errors)
                     local_files = local_dirs = local_errors = 0
 
             while True:
-                task = q.get()
+                task = q.get(worker_id)
                 if task is None:
                     _flush_local()
                     break
@@ -246,8 +344,46 @@ class ThreadedScannerBase(ABC):
                     # subdirectories are only enqueued if we haven't hit max_depth.
                     within_depth = options.max_depth is None or task.depth < options.max_depth
                     if within_depth:
+                        # Prune gate: a child dir matching a prune rule is
+                        # flagged and never enqueued — its whole subtree
+                        # costs zero further syscalls.
+                        if options.prune_dirs:
+                            kept: list[ScanNode] = []
+                            for child in dir_children:
+                                if child.name.lower() in options.prune_dirs:
+                                    child.unexpanded = True
+                                else:
+                                    kept.append(child)
+                            dir_children = kept
+                        # Sampling gate (estimation mode): below
+                        # sample_depth, enqueue only a random fraction
+                        # of subdirectories; the rest are left as
+                        # estimated holes for extrapolate_estimates to
+                        # fill from their scanned siblings.  The RNG is
+                        # seeded with the directory path, so a given
+                        # tree always samples the same subset —
+                        # reproducible runs, comparable snapshots.
+                        if (
+                            options.sample_depth is not None
+                            and task.depth >= options.sample_depth
+                            and len(dir_children) > 1
+                        ):
+                            keep_n = max(1, math.ceil(options.sample_fraction * len(dir_children)))
+                            if keep_n < len(dir_children):
+                                rng = random.Random(task.node.path)
+                                chosen = set(rng.sample(range(len(dir_children)), keep_n))
+                                sampled: list[ScanNode] = []
+                                for i, child in enumerate(dir_children):
+                                    if i in chosen:
+                                        sampled.append(child)
+                                    else:
+                                        child.unexpanded = True
+                                        child.estimated = True
+                                dir_children = sampled
                         next_depth = task.depth + 1
-                        q.put_many(_Task(n, next_depth) for n in dir_children)
+                        q.put_many(
+                            (_Task(n, next_depth) for n in dir_children), worker_id
+                        )
 
                     # Emit progress roughly every 100 items (integer division
                     # trick: fires when the count crosses a 100-boundary).
@@ -263,8 +399,10 @@ class ThreadedScannerBase(ABC):
                     _flush_local()
                     q.task_done()
 
-        num_workers = self._workers
-        threads = [threading.Thread(target=run_worker, daemon=True) for _ in range(num_workers)]
+        threads = [
+            threading.Thread(target=run_worker, args=(wid,), daemon=True)
+            for wid in range(num_workers)
+        ]
         for thread in threads:
             thread.start()
         # join() waits until all enqueued tasks are done.  Only then do we
@@ -278,6 +416,8 @@ class ThreadedScannerBase(ABC):
             thread.join(timeout=0.3)
 
         if cancelled.is_set():
+            if options.profile:
+                prof_enable(False)
             return Err(
                 ScanError(
                     code=ScanErrorCode.CANCELLED,
@@ -287,6 +427,56 @@ class ThreadedScannerBase(ABC):
             )
 
         # All workers are done.  Aggregate child sizes bottom-up and sort
-        # children by disk_usage descending, then freeze into a snapshot.
-        finalize_sizes(root_node)
-        return Ok(ScanSnapshot(root=root_node, stats=stats))
+        # children by disk_usage descending (top-level subtrees in
+        # parallel), then freeze into a snapshot.
+        finalize_t0 = time.perf_counter()
+        finalize_sizes_parallel(root_node, workers=num_workers, top_dirs=top_dirs)
+        finalize_elapsed = time.perf_counter() - finalize_t0
+        files, dirs, errors = counters.snapshot()
+        stats = ScanStats(files=files, directories=dirs, access_errors=errors)
+
+        if options.profile:
+            prof_enable(False)
+            c = prof_snapshot()
+            wall = time.perf_counter() - scan_t0
+            # Walker times are summed across workers, so they can exceed
+            # the wall time; C counters stay zero for the Python scanner
+            # (it never enters the instrumented walkers).
+            stats.profile = {
+                "wall_s": wall,
+                "entries_per_s": (files + dirs) / wall if wall else 0.0,
+                "finalize_s": finalize_elapsed,
+                "walker_io_s": c["io_ns"] / 1e9,
+                "walker_gil_wait_s": c["gil_wait_ns"] / 1e9,
+                "walker_build_s": c["build_ns"] / 1e9,
+                "walker_calls": float(c["calls"]),
+                "queue_steals": float(q.steals),
+                "queue_parks": float(q.parks),
+                "queue_park_s": q.park_seconds,
+            }
+
+        # Estimation mode: fill the sampled-out holes from their scanned
+        # siblings and compute the root confidence interval.  Runs after
+        # finalize so every scanned subtree total is exact; stats remain
+        # counts of what was actually visited.
+        size_margin: int | None = None
+        disk_margin: int | None = None
+        if options.sample_depth is not None:
+            size_margin, disk_margin = extrapolate_estimates(root_node)
+
+        top_files_list: list[ScanNode] | None = None
+        top_dirs_list: list[ScanNode] | None = None
+        if self._top_files is not None and top_dirs is not None:
+            top_files_list = self._top_files.result()
+            top_dirs_list = [n for n in top_dirs.result() if n is not root_node]
+            top_dirs_list = top_dirs_list[: options.top_n]
+        return Ok(
+            ScanSnapshot(
+                root=root_node,
+                stats=stats,
+                top_files=top_files_list,
+                top_dirs=top_dirs_list,
+                size_margin=size_margin,
+                disk_margin=disk_margin,
+            )
+        )
@@ -19,12 +19,24 @@ class PythonScanner(ThreadedScannerBase):
                 errors += 1
                 continue
             if st.is_dir:
-                node = ScanNode.directory(entry.path, entry.name)
+                node = ScanNode.directory(entry.name, parent=parent)
                 parent.children.append(node)
-                dir_children.append(node)
+                # One-filesystem mode: dirs on another device are mount
+                # points — kept as leaves, never enqueued for scanning.
+                if self._root_dev == 0 or st.dev == self._root_dev:
+                    dir_children.append(node)
                 dirs += 1
             else:
-                node = ScanNode.file(entry.path, entry.name, st.size, st.disk_usage)
+                size, usage = st.size, st.disk_usage
+                # Hardlink dedup: later links to an already-seen inode
+                # stay in the tree but contribute zero bytes.
+                iset = self._inode_set
+                if iset is not None and st.nlink > 1 and not iset.add(st.dev, st.ino):
+                    size = usage = 0
+                node = ScanNode.file(entry.name, size, usage, parent=parent)
                 parent.children.append(node)
+                top = self._top_files
+                if top is not None:
+                    top.push(usage, node)
                 files += 1
         return dir_children, files, dirs, errors
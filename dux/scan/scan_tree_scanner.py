@@ -0,0 +1,94 @@
+# Scanner built on the dux._scan_tree struct-of-arrays container.
+#
+# Unlike the ThreadedScannerBase family, the whole walk happens inside one
+# C call with the GIL released, and the result tree lives in parallel C
+# arrays instead of per-entry ScanNode objects.  That trades mid-scan
+# progress updates and cancellation for the lowest possible memory
+# footprint — the right trade on volumes too large to hold as Python
+# objects at all.
+
+from __future__ import annotations
+
+from result import Err, Ok
+
+from dux.models.enums import NodeKind
+from dux.models.scan import (
+    CancelCheck,
+    ProgressCallback,
+    ScanError,
+    ScanErrorCode,
+    ScanOptions,
+    ScanResult,
+    ScanSnapshot,
+    ScanStats,
+)
+from dux.scan._base import resolve_root
+from dux.services.fs import DEFAULT_FS, FileSystem
+
+
+class ScanTreeScanner:
+    """Single-call C scanner producing a ScanTree-backed snapshot.
+
+    The snapshot's root is a ``ScanTreeNode`` handle, which duck-types
+    ``ScanNode`` for everything downstream reads (name/path/kind/sizes/
+    children).  ``workers`` is accepted for interface parity; the C walk
+    is single-threaded.  ``options.dedup_hardlinks``,
+    ``options.one_filesystem`` and ``options.prune_dirs`` are not
+    supported here (the CLI warns and clears them for this scanner).
+    """
+
+    def __init__(self, workers: int = 1, fs: FileSystem = DEFAULT_FS) -> None:
+        del workers
+        self._fs = fs
+
+    def scan(
+        self,
+        path: str,
+        options: ScanOptions,
+        progress_callback: ProgressCallback | None = None,
+        cancel_check: CancelCheck | None = None,
+    ) -> ScanResult:
+        from dux._scan_tree import ScanTree
+
+        resolved = resolve_root(path, self._fs)
+        if isinstance(resolved, ScanError):
+            return Err(resolved)
+
+        # The C walk cannot be interrupted, so cancellation is only
+        # honoured at the boundary.
+        if cancel_check is not None and cancel_check():
+            return Err(
+                ScanError(
+                    code=ScanErrorCode.CANCELLED,
+                    path=resolved,
+                    message="Scan cancelled",
+                )
+            )
+
+        max_depth = -1 if options.max_depth is None else options.max_depth
+        try:
+            tree = ScanTree.scan(resolved, NodeKind.DIRECTORY, NodeKind.FILE, max_depth)
+        except OSError as exc:
+            return Err(
+                ScanError(
+                    code=ScanErrorCode.ROOT_STAT_FAILED,
+                    path=resolved,
+                    message=f"Cannot read root: {exc}",
+                )
+            )
+        tree.finalize()
+
+        if progress_callback is not None:
+            progress_callback(resolved, tree.file_count, tree.dir_count)
+
+        stats = ScanStats(
+            files=tree.file_count,
+            directories=tree.dir_count,
+            access_errors=tree.error_count,
+        )
+        return Ok(
+            ScanSnapshot(
+                root=tree.root,  # type: ignore[arg-type]  # handle duck-types ScanNode
+                stats=stats,
+            )
+        )
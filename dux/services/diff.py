@@ -0,0 +1,71 @@
+# Snapshot diff: growth attribution between two scans of the same root.
+#
+# The merge itself runs in C over the two trees' flat arrays
+# (ScanTree.diff — GIL released, no Python objects for unchanged nodes),
+# which is what makes diffing two 50M-node snapshots practical in CI.
+# This module wraps the raw records in DiffEntry and orders them for
+# display.
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+from dux._scan_tree import ScanTreeNode
+from dux.models.enums import DiffStatus
+from dux.models.scan import ScanSnapshot
+
+# Index-aligned with the DIFF_CHANGED/DIFF_ADDED/DIFF_REMOVED constants
+# exported by dux._scan_tree.
+_STATUS_BY_CODE = (DiffStatus.CHANGED, DiffStatus.ADDED, DiffStatus.REMOVED)
+
+
+@dataclass(slots=True, frozen=True)
+class DiffEntry:
+    """One changed path between two snapshots.
+
+    For directories the deltas cover the whole subtree: ``delta_disk`` is
+    the net growth in allocated bytes, ``nodes_added``/``nodes_removed``
+    count descendants that appeared/disappeared.  ADDED and REMOVED
+    entries describe entire new or vanished subtrees.
+    """
+
+    path: str
+    is_dir: bool
+    status: DiffStatus
+    delta_size: int
+    delta_disk: int
+    nodes_added: int
+    nodes_removed: int
+
+
+def diff_snapshots(old: ScanSnapshot, new: ScanSnapshot) -> list[DiffEntry]:
+    """Compute per-subtree deltas from *old* to *new*.
+
+    Both snapshots must be ScanTree-backed (scanned with ``--scanner
+    compact`` or loaded via ``snapshot_io``) and cover the same root.
+    Entries come back sorted by absolute disk delta, biggest movers
+    first; the root's own summary entry is included.  Raises
+    ``TypeError`` for ScanNode-object snapshots and ``ValueError`` when
+    the roots differ.
+    """
+    for name, snap in (("old", old), ("new", new)):
+        if not isinstance(snap.root, ScanTreeNode):
+            raise TypeError(
+                f"diff_snapshots requires ScanTree-backed snapshots; the "
+                f"{name} snapshot has a {type(snap.root).__name__} root"
+            )
+    raw = new.root.tree.diff(old.root.tree)  # type: ignore[union-attr]
+    entries = [
+        DiffEntry(
+            path=path,
+            is_dir=is_dir,
+            status=_STATUS_BY_CODE[status],
+            delta_size=delta_size,
+            delta_disk=delta_disk,
+            nodes_added=nodes_added,
+            nodes_removed=nodes_removed,
+        )
+        for path, is_dir, status, delta_size, delta_disk, nodes_added, nodes_removed in raw
+    ]
+    entries.sort(key=lambda e: abs(e.delta_disk), reverse=True)
+    return entries
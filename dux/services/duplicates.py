@@ -0,0 +1,160 @@
+# Duplicate-file finder: size buckets from the scan tree, content
+# confirmation via sampled hashes.
+#
+# The scan tree already holds every file's exact size, so candidate
+# generation is free: only files sharing a size with another file can be
+# duplicates.  Confirmation escalates through two hashing passes over the
+# shrinking candidate set — sampled head/middle/tail fingerprints first,
+# full-content hashes only for sampled-hash survivors that have content
+# beyond the sampled span.  Both passes run in dux._hasher with the GIL
+# released per batch, fanned out over worker threads the same way
+# finalize_sizes_parallel distributes subtrees.
+
+from __future__ import annotations
+
+import threading
+from collections.abc import Callable, Iterable
+from dataclasses import dataclass
+
+from dux._hasher import SAMPLE_SPAN, hash_full, hash_sampled
+from dux.models.scan import ScanNode
+
+# Files below this are ignored by default: tiny duplicates are legion
+# (empty __init__.py, LICENSE copies) and reclaim next to nothing.
+DEFAULT_MIN_SIZE = 1 << 20
+
+# Paths per hashing batch.  Small enough that workers load-balance over
+# the shared batch iterator, large enough to amortize the per-call GIL
+# round-trip.
+_BATCH = 64
+
+
+@dataclass(slots=True, frozen=True)
+class DuplicateGroup:
+    """Files confirmed to share identical content.
+
+    ``size_bytes``/``disk_usage`` describe one copy; ``paths`` is sorted
+    and always holds at least two entries.
+    """
+
+    size_bytes: int
+    disk_usage: int
+    paths: tuple[str, ...]
+
+    @property
+    def reclaimable(self) -> int:
+        """Disk bytes freed by keeping one copy."""
+        return self.disk_usage * (len(self.paths) - 1)
+
+
+def _hash_parallel(
+    hash_fn: Callable[[list[str]], list[int | None]],
+    paths: list[str],
+    workers: int,
+) -> dict[str, int | None]:
+    """Run *hash_fn* over *paths* in batches across *workers* threads."""
+    batches = [paths[i : i + _BATCH] for i in range(0, len(paths), _BATCH)]
+    results: dict[str, int | None] = {}
+    if workers <= 1 or len(batches) < 2:
+        for batch in batches:
+            results.update(zip(batch, hash_fn(batch), strict=True))
+        return results
+
+    it = iter(batches)
+    lock = threading.Lock()
+
+    def run_worker() -> None:
+        while True:
+            with lock:
+                batch = next(it, None)
+            if batch is None:
+                return
+            hashes = hash_fn(batch)
+            with lock:
+                results.update(zip(batch, hashes, strict=True))
+
+    threads = [
+        threading.Thread(target=run_worker, daemon=True)
+        for _ in range(min(workers, len(batches)))
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    return results
+
+
+def _regroup(
+    buckets: Iterable[list[ScanNode]],
+    hashes: dict[str, int | None],
+) -> list[list[ScanNode]]:
+    """Split each bucket by hash; drop errors and singletons."""
+    out: list[list[ScanNode]] = []
+    for bucket in buckets:
+        by_hash: dict[int, list[ScanNode]] = {}
+        for node in bucket:
+            h = hashes.get(node.path)
+            if h is not None:
+                by_hash.setdefault(h, []).append(node)
+        out.extend(group for group in by_hash.values() if len(group) > 1)
+    return out
+
+
+def find_duplicates(
+    root: ScanNode,
+    *,
+    min_size: int = DEFAULT_MIN_SIZE,
+    workers: int = 4,
+) -> list[DuplicateGroup]:
+    """Find groups of identical files under *root*, largest reclaim first.
+
+    Candidates come from the already-scanned tree (no re-stat); content
+    is confirmed by sampled and then full hashing.  Files that vanish or
+    become unreadable between scan and confirmation drop out silently —
+    the scan's access-error accounting does not apply here.  Hardlinked
+    copies of one inode are reported as duplicates like any others; the
+    tree does not retain inode numbers.
+    """
+    # Size buckets straight off the tree.
+    by_size: dict[int, list[ScanNode]] = {}
+    stack = [root]
+    while stack:
+        node = stack.pop()
+        for child in node.children:
+            if child.is_dir:
+                stack.append(child)
+            elif child.size_bytes >= min_size:
+                by_size.setdefault(child.size_bytes, []).append(child)
+    buckets = [bucket for bucket in by_size.values() if len(bucket) > 1]
+
+    # Pass 1: sampled fingerprints over every candidate.
+    candidates = [node.path for bucket in buckets for node in bucket]
+    if not candidates:
+        return []
+    buckets = _regroup(buckets, _hash_parallel(hash_sampled, candidates, workers))
+
+    # Pass 2: full hashes, but only where the sample left content unseen.
+    survivors = [
+        node.path
+        for bucket in buckets
+        for node in bucket
+        if bucket[0].size_bytes > SAMPLE_SPAN
+    ]
+    if survivors:
+        full_hashes = _hash_parallel(hash_full, survivors, workers)
+        confirmed = [b for b in buckets if b[0].size_bytes <= SAMPLE_SPAN]
+        confirmed.extend(_regroup(
+            (b for b in buckets if b[0].size_bytes > SAMPLE_SPAN), full_hashes
+        ))
+        buckets = confirmed
+
+    groups = [
+        DuplicateGroup(
+            size_bytes=bucket[0].size_bytes,
+            disk_usage=max(node.disk_usage for node in bucket),
+            paths=tuple(sorted(node.path for node in bucket)),
+        )
+        for bucket in buckets
+    ]
+    groups.sort(key=lambda g: g.reclaimable, reverse=True)
+    return groups
@@ -16,6 +16,14 @@ def format_bytes(size: int) -> str:
     return f"{value:.1f} {UNITS[unit]}"
 
 
+def format_delta(delta: int) -> str:
+    """Signed byte delta for diff views: '+1.5 MB', '-320 KB', '0 B'."""
+    if delta == 0:
+        return "0 B"
+    sign = "+" if delta > 0 else "-"
+    return f"{sign}{format_bytes(abs(delta))}"
+
+
 def relative_path(absolute_path: str, root_prefix: str) -> str:
     if absolute_path.startswith(root_prefix):
         return absolute_path[len(root_prefix) :]
@@ -12,6 +12,11 @@ class StatResult:
     size: int
     is_dir: bool
     disk_usage: int = 0
+    # Inode identity for hardlink dedup.  The defaults (single link,
+    # null identity) mean fakes that omit them are never deduped.
+    nlink: int = 1
+    dev: int = 0
+    ino: int = 0
 
 
 @dataclass(slots=True, frozen=True)
@@ -53,6 +58,9 @@ class OsFileSystem:
             # st_blocks is always in 512-byte units (POSIX convention),
             # regardless of the filesystem's actual block size.
             disk_usage=st.st_blocks * 512,
+            nlink=st.st_nlink,
+            dev=st.st_dev,
+            ino=st.st_ino,
         )
 
     def scandir(self, path: str) -> Iterable[DirEntry]:
@@ -64,6 +72,9 @@ class OsFileSystem:
                         size=st.st_size,
                         is_dir=statmod.S_ISDIR(st.st_mode),
                         disk_usage=st.st_blocks * 512,
+                        nlink=st.st_nlink,
+                        dev=st.st_dev,
+                        ino=st.st_ino,
                     )
                 except OSError:
                     sr = None
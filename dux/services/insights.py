@@ -7,7 +7,9 @@ from dux.config.schema import AppConfig, PatternRule
 from dux.models.enums import ApplyTo, InsightCategory
 from dux.models.insight import CategoryStats, Insight, InsightBundle
 from dux.models.scan import ScanNode
-from dux.services.patterns import CompiledRuleSet, compile_ruleset, match_all
+from dux._ruleset import CompiledRuleSetNative
+from dux.services.duplicates import DuplicateGroup
+from dux.services.patterns import compile_ruleset_native_cached
 
 # Heap entry: (disk_usage, path, Insight).  Using disk usage as the key so the
 # smallest item sits at the top of the min-heap for efficient eviction.
@@ -44,10 +46,12 @@ def generate_insights(root: ScanNode, config: AppConfig) -> InsightBundle:
     Pipeline:
       1. Wrap ``additional_paths`` as synthetic PatternRule objects so they
          go through the same matching pipeline as glob patterns.
-      2. Compile all rules into a CompiledRuleSet (fast hash/AC dispatch).
-      3. DFS traversal: match each node, record insights into per-category
-         bounded min-heaps (top-K by disk_usage) and unbounded aggregate
-         counters (for overview totals in the TUI).
+      2. Compile all rules into a CompiledRuleSetNative (all matcher
+         tiers folded into one C object).
+      3. Wave traversal: match each frontier of nodes in one batched
+         match_many call, record insights into per-category bounded
+         min-heaps (top-K by disk_usage) and unbounded aggregate counters
+         (for overview totals in the TUI).
       4. Extract and deduplicate the heaps into a flat sorted list.
     """
     # --- build additional path rules ---
@@ -70,8 +74,10 @@ def generate_insights(root: ScanNode, config: AppConfig) -> InsightBundle:
                 )
             )
 
-    # --- compile all rules into a single dispatch structure ---
-    ruleset: CompiledRuleSet = compile_ruleset(
+    # --- compile all rules into a single native dispatch structure ---
+    # Cached variant: warm starts mmap the built matcher back instead of
+    # re-running brace expansion and the automaton build every invocation.
+    ruleset: CompiledRuleSetNative = compile_ruleset_native_cached(
         config.patterns,
         additional_paths=additional_paths or None,
     )
@@ -100,45 +106,41 @@ def generate_insights(root: ScanNode, config: AppConfig) -> InsightBundle:
     # (avoids repeated attribute access in the hot loop).
     _temp_cache = {_TEMP.value, _CACHE.value}
 
-    # The traversal uses two pruning mechanisms:
-    #   1. in_temp_or_cache — skips children of dirs already matched as TEMP
-    #      or CACHE, because the parent's aggregate size already covers them.
+    # The traversal proceeds in waves: every node in the current frontier
+    # is matched with one native match_many call (every tier — exact hash,
+    # Aho-Corasick, prefix trie, glob, additional paths — runs in C with
+    # the GIL released for the whole batch), then the survivors' children
+    # form the next frontier.  Two pruning mechanisms keep the
+    # frontiers small:
+    #   1. temp/cache dirs — their children are never enqueued, because
+    #      the parent's aggregate size already covers them.
     #   2. stop_recursion (via build_rule) — skips children of dirs like
     #      node_modules to avoid wasting time on uninteresting subtrees.
-    stack: list[tuple[ScanNode, bool]] = [(root, False)]
-    while stack:
-        node, in_temp_or_cache = stack.pop()
-
-        if in_temp_or_cache:
-            continue
-
-        path = node.path
-        basename = node.name
-        is_dir = node.is_dir
-
-        # Lowercase once per entry for case-insensitive pattern matching.
-        lpath = path.lower()
-        lbase = basename.lower()
-
-        # Single-pass match across all categories
-        matched_rules = match_all(ruleset, lpath, lbase, is_dir)
-
-        local_in_temp_cache = False
-        build_rule: PatternRule | None = None
-        for rule in matched_rules:
-            _record(_insight_from_rule(node, rule))
-            if rule.category.value in _temp_cache:
-                local_in_temp_cache = True
-            if rule.stop_recursion:
-                build_rule = rule
-
-        if is_dir:
-            if build_rule is not None:
-                continue
-            # Reverse before pushing onto the LIFO stack so children are
-            # visited in their original order (largest disk_usage first).
-            for child in reversed(node.children):
-                stack.append((child, local_in_temp_cache))
+    frontier: list[ScanNode] = [root]
+    while frontier:
+        keys: list[tuple[str, str, bool]] = []
+        for node in frontier:
+            # node.name is parent-relative; parentless anchors (the scan
+            # root) hold their full path there, so derive the basename
+            # explicitly.  Lowercase once per entry for case-insensitive
+            # pattern matching.
+            basename = node.name.rsplit("/", 1)[-1]
+            keys.append((node.path.lower(), basename.lower(), node.is_dir))
+
+        next_frontier: list[ScanNode] = []
+        for node, matched_rules in zip(frontier, ruleset.match_many(keys), strict=True):
+            local_in_temp_cache = False
+            build_rule: PatternRule | None = None
+            for rule in matched_rules:
+                _record(_insight_from_rule(node, rule))
+                if rule.category.value in _temp_cache:
+                    local_in_temp_cache = True
+                if rule.stop_recursion:
+                    build_rule = rule
+
+            if node.is_dir and build_rule is None and not local_in_temp_cache:
+                next_frontier.extend(node.children)
+        frontier = next_frontier
 
     # --- merge heaps into a single sorted list ---
     # Phase 2 of the lazy dedup strategy (see _heap_push): stale entries
@@ -174,5 +176,43 @@ def _insight_from_rule(node: ScanNode, rule: PatternRule) -> Insight:
     )
 
 
+def merge_duplicate_insights(
+    bundle: InsightBundle,
+    groups: list[DuplicateGroup],
+    max_insights: int,
+) -> InsightBundle:
+    """Fold dedup-engine results into *bundle* as DUPLICATE insights.
+
+    Duplicates come from content hashing (services/duplicates.py), not
+    from pattern rules, so they bypass generate_insights and are merged
+    here: every copy in every group becomes an insight (the aggregate
+    counters see them all), bounded to the top *max_insights* by disk
+    usage like any other category.  Returns a new bundle sharing the
+    updated ``by_category`` dict.
+    """
+    heap: list[_HeapEntry] = []
+    seen: dict[str, int] = {}
+    stats = bundle.by_category.setdefault(InsightCategory.DUPLICATE, CategoryStats())
+    for group in groups:
+        summary = f"Duplicate x{len(group.paths)}"
+        for path in group.paths:
+            insight = Insight(
+                path=path,
+                size_bytes=group.size_bytes,
+                category=InsightCategory.DUPLICATE,
+                summary=summary,
+                disk_usage=group.disk_usage,
+            )
+            stats.count += 1
+            stats.size_bytes += insight.size_bytes
+            stats.disk_usage += insight.disk_usage
+            stats.paths.add(path)
+            _heap_push(heap, seen, insight, max_insights)
+
+    merged = bundle.insights + [entry[2] for entry in heap]
+    merged.sort(key=lambda x: x.disk_usage, reverse=True)
+    return InsightBundle(insights=merged, by_category=bundle.by_category)
+
+
 def filter_insights(bundle: InsightBundle, categories: set[InsightCategory]) -> list[Insight]:
     return [item for item in bundle.insights if item.category in categories]
@@ -55,14 +55,29 @@
 #     4. GLOB              — fnmatch fallback.
 #     5. Additional paths  — literal path prefix checks for user-configured
 #                            directories (e.g. ~/.cache).
+#
+#   match_many is the batched form: it runs tier 2 for a whole list of
+#   nodes through a single ac.iter_many() call (GIL released in C),
+#   amortizing the per-node call transition and skipping result
+#   allocation for the zero-match common case.
+#
+#   WARM START — compile_ruleset_native_cached persists the built native
+#   matcher to a cache file keyed on a hash of the registration stream,
+#   so repeat invocations mmap the arrays back instead of re-running
+#   phase 1 (see the binary cache format notes in csrc/ruleset.c).
 
 from __future__ import annotations
 
+import hashlib
+import os
+from collections.abc import Iterator
 from dataclasses import dataclass, field
 from fnmatch import fnmatch
+from pathlib import Path
 
 from dux._ac_matcher import AhoCorasick
 from dux._prefix_trie import PrefixTrie
+from dux._ruleset import CompiledRuleSetNative
 
 from dux.config.schema import PatternRule
 from dux.models.enums import ApplyTo
@@ -298,24 +313,18 @@ def compile_ruleset(
     )
 
 
-def match_all(
-    rs: CompiledRuleSet,
+def _match_one(
+    bk: _ByKind,
     lpath: str,
     lbase: str,
-    is_dir: bool,
+    ac_hits: list[tuple[int, list[tuple[PatternRule, bool]]]],
 ) -> list[PatternRule]:
-    """Return all matching rules for a node, one pass across all categories.
-
-    *lpath* and *lbase* must be pre-lowercased.  Additional path bases are
-    also pre-lowercased at compile time, so the comparison is consistent.
+    """Tier dispatch shared by match_all and match_many.
 
-    Returns at most one rule per category (first match wins).
-
-    Perf: this function is called once per node during the insight traversal
-    (millions of times on large trees).  The first-match-per-category check
-    is inlined at every tier to avoid a closure allocation per call.
+    *ac_hits* carries the Aho-Corasick results for *lpath* — computed per
+    call by match_all, or pulled from a batched iter_many call by
+    match_many.  Pass an empty list when the kind has no automaton.
     """
-    bk = rs.for_dir if is_dir else rs.for_file
     matched: list[PatternRule] = []
     seen: set[str] = set()
 
@@ -334,14 +343,14 @@ def match_all(
                 matched.append(rule)
 
     # --- CONTAINS + ENDSWITH: Aho-Corasick automaton ---
-    # A single ac.iter() call finds all CONTAINS and ENDSWITH matches.
+    # ac_hits holds all CONTAINS and ENDSWITH matches for this path.
     # end_only=True (set at compile time in _build_ac) restricts ENDSWITH
     # and CONTAINS-alt hits to fire only when the match ends at the last
     # character of the path — this is the runtime enforcement of the
     # "match at end of path" semantic.
-    if bk.ac is not None:
+    if ac_hits:
         _lpath_end = len(lpath) - 1
-        for end_idx, entries in bk.ac.iter(lpath):
+        for end_idx, entries in ac_hits:
             for rule, end_only in entries:
                 if end_only and end_idx != _lpath_end:
                     continue
@@ -377,3 +386,217 @@ def match_all(
                     matched.append(rule)
 
     return matched
+
+
+# Shared read-only "no AC matches" sentinel so per-node calls on trees
+# without CONTAINS/ENDSWITH rules allocate nothing.
+_NO_HITS: list[tuple[int, list[tuple[PatternRule, bool]]]] = []
+
+
+def _native_ops(
+    rules: list[PatternRule],
+    additional_paths: list[tuple[str, PatternRule]] | None,
+) -> Iterator[tuple[str, int, str, PatternRule, bool]]:
+    """Yield the native registration stream as (method, kind, key, rule, end_only).
+
+    One tuple per add_* call — and therefore one per REntry the C side
+    creates — in a deterministic order.  Both the cold compile and the
+    warm-start cache consume this stream: the compile drives the add_*
+    calls from it, while the cache hashes it for the file key and uses
+    the per-tuple rules to re-attach Python objects on load.
+    """
+    kinds = {_FILE: 0, _DIR: 1}
+    for rule in rules:
+        at = rule.apply_to
+        for expanded_pat in _expand_braces(rule.pattern):
+            m = _classify(expanded_pat)
+            for flag, kind in kinds.items():
+                if not (at & flag):
+                    continue
+                if m.kind == _EXACT:
+                    yield ("add_exact", kind, m.value, rule, False)
+                elif m.kind == _CONTAINS:
+                    # Same two-key scheme as _build_ac: anywhere + end-only.
+                    yield ("add_substring", kind, m.value, rule, False)
+                    yield ("add_substring", kind, m.alt, rule, True)
+                elif m.kind == _ENDSWITH:
+                    yield ("add_substring", kind, m.value, rule, True)
+                elif m.kind == _STARTSWITH:
+                    yield ("add_prefix", kind, m.value, rule, False)
+                else:
+                    yield ("add_glob", kind, m.value, rule, False)
+
+    if additional_paths:
+        for base, rule in additional_paths:
+            for flag, kind in kinds.items():
+                if rule.apply_to & flag:
+                    yield ("add_path", kind, base, rule, False)
+
+
+def compile_ruleset_native(
+    rules: list[PatternRule],
+    additional_paths: list[tuple[str, PatternRule]] | None = None,
+) -> CompiledRuleSetNative:
+    """Build a CompiledRuleSetNative from all rules.
+
+    Same classification pipeline as compile_ruleset (brace expansion,
+    _classify, apply_to distribution), but the result lives entirely in C:
+    exact hash table, Aho-Corasick automaton, prefix trie, glob fallback
+    and additional-path prefixes behind a single ``match()`` call — no
+    Python glue between tiers on the per-node hot path.  Categories are
+    mapped to small ints here; the C side tracks first-match-wins per
+    category in a bitmask.
+
+    The glob tier compiles each pattern once into a C segment program
+    with fnmatch semantics, so even fallback rules cost a linear scan
+    per node instead of a regex-cache lookup.
+    """
+    rs = CompiledRuleSetNative()
+    cat_ids: dict[str, int] = {}
+    for method, kind, key, rule, end_only in _native_ops(rules, additional_paths):
+        cat = cat_ids.setdefault(rule.category.value, len(cat_ids))
+        if method == "add_substring":
+            rs.add_substring(kind, key, rule, cat, end_only)
+        else:
+            getattr(rs, method)(kind, key, rule, cat)
+    rs.build()
+    return rs
+
+
+# Bumped whenever the registration stream's meaning changes in a way the
+# hashed text would not capture (the C side guards its own binary layout
+# with the file magic).
+_RULESET_CACHE_VERSION = 1
+RULESET_CACHE_DIR = "~/.cache/dux"
+
+
+def compile_ruleset_native_cached(
+    rules: list[PatternRule],
+    additional_paths: list[tuple[str, PatternRule]] | None = None,
+    cache_dir: str | None = None,
+) -> CompiledRuleSetNative:
+    """compile_ruleset_native with a persisted warm-start cache.
+
+    The full registration stream (every add_* call the compile would
+    make) is hashed into the cache-file name, so any config change —
+    a new rule, an edited pattern, a different category — misses the
+    cache and recompiles.  On a hit the built matcher arrays are
+    mmap'd back via ``CompiledRuleSetNative.load`` and the fresh rule
+    objects re-attached by index: no brace expansion, no trie
+    insertion, no automaton BFS on startup.
+
+    Cache failures are never fatal: an unreadable, stale-format or
+    unwritable cache silently falls back to a cold compile.
+    """
+    ops = list(_native_ops(rules, additional_paths))
+    cat_ids: dict[str, int] = {}
+    lines = [f"v{_RULESET_CACHE_VERSION}"]
+    entry_rules: list[PatternRule] = []
+    for method, kind, key, rule, end_only in ops:
+        cat = cat_ids.setdefault(rule.category.value, len(cat_ids))
+        lines.append(f"{method}\x00{kind}\x00{key}\x00{cat}\x00{int(end_only)}")
+        entry_rules.append(rule)
+    digest = hashlib.sha256("\n".join(lines).encode()).hexdigest()[:16]
+
+    directory = Path(cache_dir if cache_dir is not None else RULESET_CACHE_DIR).expanduser()
+    path = directory / f"ruleset-{digest}.bin"
+    try:
+        return CompiledRuleSetNative.load(str(path), entry_rules)
+    except (OSError, ValueError):
+        pass
+
+    rs = compile_ruleset_native(rules, additional_paths)
+    try:
+        directory.mkdir(parents=True, exist_ok=True)
+        # Write-then-rename so concurrent dux invocations never map a
+        # half-written file; stale keys from old configs are swept here
+        # too, since only the current one can ever hit again.
+        tmp = path.with_name(f"{path.name}.{os.getpid()}.tmp")
+        rs.save(str(tmp))
+        os.replace(tmp, path)
+        for old in directory.glob("ruleset-*.bin"):
+            if old != path:
+                old.unlink(missing_ok=True)
+    except OSError:
+        pass
+    return rs
+
+
+def prune_dir_basenames(rules: list[PatternRule]) -> frozenset[str]:
+    """Directory basenames whose subtrees can be pruned during the scan.
+
+    A ``stop_recursion`` dir rule of shape ``**/name`` (EXACT) or
+    ``**/name/**`` (CONTAINS, single segment) reduces to a basename test
+    the scanner can apply before descending — the whole subtree is
+    skipped and later labelled from the directory node alone.  Other
+    shapes (multi-segment CONTAINS, globs) need the descendant paths to
+    match, so they never prune.  Basenames are lowercased to match the
+    case-insensitive pipeline.
+    """
+    names: set[str] = set()
+    for rule in rules:
+        if not rule.stop_recursion or not (rule.apply_to & _DIR):
+            continue
+        for expanded_pat in _expand_braces(rule.pattern):
+            m = _classify(expanded_pat)
+            if m.kind == _EXACT:
+                names.add(m.value)
+            elif m.kind == _CONTAINS:
+                segment = m.value.strip("/")
+                if "/" not in segment:
+                    names.add(segment)
+    return frozenset(names)
+
+
+def match_all(
+    rs: CompiledRuleSet,
+    lpath: str,
+    lbase: str,
+    is_dir: bool,
+) -> list[PatternRule]:
+    """Return all matching rules for a node, one pass across all categories.
+
+    *lpath* and *lbase* must be pre-lowercased.  Additional path bases are
+    also pre-lowercased at compile time, so the comparison is consistent.
+
+    Returns at most one rule per category (first match wins).
+
+    Perf: the first-match-per-category check is inlined at every tier in
+    _match_one to avoid a closure allocation per call.  Callers matching
+    many nodes should prefer match_many, which batches the Aho-Corasick
+    tier through one C call instead of one per node.
+    """
+    bk = rs.for_dir if is_dir else rs.for_file
+    ac_hits = bk.ac.iter(lpath) if bk.ac is not None else _NO_HITS
+    return _match_one(bk, lpath, lbase, ac_hits)
+
+
+def match_many(
+    rs: CompiledRuleSet,
+    items: list[tuple[str, str, bool]],
+) -> list[list[PatternRule]]:
+    """Batched match_all over (lpath, lbase, is_dir) triples.
+
+    The Aho-Corasick tier dominates match_all's cost on large trees — not
+    the matching itself, but the Python-to-C call transition plus a result
+    list allocated per node even when nothing matches (the common case).
+    This runs one ``iter_many`` call per node kind with the GIL released;
+    only paths that actually matched come back as Python objects.  The
+    remaining tiers (exact/prefix/glob/additional) are cheap pure-Python
+    lookups and stay per-node.
+
+    Returns one rule list per input item, in input order.
+    """
+    ac_hits: list[list[tuple[int, list[tuple[PatternRule, bool]]]]] = [_NO_HITS] * len(items)
+    for want_dir, bk in ((True, rs.for_dir), (False, rs.for_file)):
+        if bk.ac is None:
+            continue
+        idxs = [i for i, (_, _, is_dir) in enumerate(items) if is_dir is want_dir]
+        if not idxs:
+            continue
+        for j, hits in bk.ac.iter_many([items[i][0] for i in idxs]):
+            ac_hits[idxs[j]] = hits
+    return [
+        _match_one(rs.for_dir if is_dir else rs.for_file, lpath, lbase, ac_hits[i])
+        for i, (lpath, lbase, is_dir) in enumerate(items)
+    ]
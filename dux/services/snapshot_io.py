@@ -0,0 +1,88 @@
+# Binary snapshot persistence for ScanTree-backed scans.
+#
+# The heavy lifting lives in dux._scan_tree: ScanTree.save dumps the
+# struct-of-arrays tree as flat fixed-width records plus a string table,
+# and ScanTree.load mmaps that file back and serves node handles straight
+# from the (copy-on-write) mapping.  Nothing is deserialized on load, so
+# reopening yesterday's scan of a huge volume costs page-cache faults,
+# not a fresh walk.  These wrappers adapt between ScanSnapshot and the
+# native container.
+
+from __future__ import annotations
+
+from dux._scan_tree import ScanTree, ScanTreeNode
+from dux.models.enums import NodeKind
+from dux.models.scan import ScanSnapshot, ScanStats
+
+
+def save_snapshot(snapshot: ScanSnapshot, path: str) -> None:
+    """Write *snapshot* to *path* in the dux binary snapshot format.
+
+    Only ScanTree-backed snapshots (produced by ``ScanTreeScanner``) can
+    be saved: the format is a dump of the native arrays, and snapshots
+    built from ScanNode objects have no such arrays.  Raises ``TypeError``
+    for other snapshots and ``OSError`` on write failure.
+    """
+    root = snapshot.root
+    if not isinstance(root, ScanTreeNode):
+        raise TypeError(
+            "save_snapshot requires a ScanTree-backed snapshot "
+            "(use --scanner compact); got a "
+            f"{type(root).__name__} root"
+        )
+    root.tree.save(path)
+
+
+def incremental_rescan(prior: ScanSnapshot, max_depth: int | None = None) -> ScanSnapshot:
+    """Rescan the prior snapshot's root, reusing unchanged subtrees.
+
+    Directories whose mtime matches the prior scan are grafted from the
+    prior tree without touching the filesystem, so a rescan where little
+    changed only walks the changed fraction.  The usual workflow is
+    ``load_snapshot`` → ``incremental_rescan`` → ``save_snapshot``.
+
+    Caveat inherent to mtime pruning: rewriting an existing file in place
+    updates the file's mtime but not its parent directory's, so such size
+    changes surface only on the next full scan.
+
+    Raises ``TypeError`` for non-ScanTree snapshots and ``OSError`` if
+    the root cannot be read.
+    """
+    root = prior.root
+    if not isinstance(root, ScanTreeNode):
+        raise TypeError(
+            "incremental_rescan requires a ScanTree-backed snapshot; got a "
+            f"{type(root).__name__} root"
+        )
+    prior_tree = root.tree
+    tree = ScanTree.scan(
+        prior_tree.root_path,
+        NodeKind.DIRECTORY,
+        NodeKind.FILE,
+        -1 if max_depth is None else max_depth,
+        prior=prior_tree,
+    )
+    tree.finalize()
+    stats = ScanStats(
+        files=tree.file_count,
+        directories=tree.dir_count,
+        access_errors=tree.error_count,
+    )
+    return ScanSnapshot(root=tree.root, stats=stats)  # type: ignore[arg-type]
+
+
+def load_snapshot(path: str) -> ScanSnapshot:
+    """Memory-map a saved snapshot and wrap it as a ``ScanSnapshot``.
+
+    The returned snapshot's root is a ``ScanTreeNode`` handle over the
+    mapped arrays, so browse/summary views read directly from the file
+    mapping.  Raises ``OSError`` if the file cannot be opened and
+    ``ValueError`` if it is not a dux snapshot.
+    """
+    tree = ScanTree.load(path, NodeKind.DIRECTORY, NodeKind.FILE)
+    stats = ScanStats(
+        files=tree.file_count,
+        directories=tree.dir_count,
+        access_errors=tree.error_count,
+    )
+    return ScanSnapshot(root=tree.root, stats=stats)  # type: ignore[arg-type]
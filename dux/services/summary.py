@@ -4,12 +4,14 @@ from rich.console import Console
 from rich.markup import escape
 from rich.table import Table
 
-from dux.models.enums import InsightCategory, NodeKind
+from dux.models.enums import DiffStatus, InsightCategory, NodeKind
 from dux.models.insight import Insight, InsightBundle
 from dux.models.scan import ScanNode, ScanStats
-from dux.services.formatting import format_bytes, relative_path
+from dux.services.diff import DiffEntry
+from dux.services.duplicates import DuplicateGroup
+from dux.services.formatting import format_bytes, format_delta, relative_path
 from dux.services.insights import filter_insights
-from dux.services.tree import top_nodes
+from dux.services.tree import extension_totals, top_nodes
 
 
 def _trim(path: str, root_prefix: str) -> str:
@@ -48,13 +50,22 @@ def _insights_table(
 
 
 def _top_nodes_table(
-    title: str, root: ScanNode, top_n: int, kind: NodeKind, root_prefix: str, *, apparent_size: bool = False
+    title: str,
+    root: ScanNode,
+    top_n: int,
+    kind: NodeKind,
+    root_prefix: str,
+    *,
+    nodes: list[ScanNode] | None = None,
+    apparent_size: bool = False,
 ) -> Table:
     table = Table(title=title, header_style="bold yellow")
     table.add_column("Path")
     _add_size_column(table, apparent_size)
     table.add_column("Disk", justify="right")
-    for node in top_nodes(root, top_n, kind):
+    # *nodes* is the scan's streaming top-N collection when available;
+    # without it, fall back to a full-tree traversal.
+    for node in nodes[:top_n] if nodes is not None else top_nodes(root, top_n, kind):
         row: list[str] = [_trim(node.path, root_prefix)]
         _append_size(row, node.size_bytes, apparent_size)
         row.append(format_bytes(node.disk_usage))
@@ -62,6 +73,24 @@ def _top_nodes_table(
     return table
 
 
+def _extension_table(
+    root: ScanNode, top_n: int, *, apparent_size: bool = False
+) -> Table:
+    table = Table(title="Disk Usage by Extension", header_style="bold yellow")
+    table.add_column("Extension")
+    table.add_column("Files", justify="right")
+    _add_size_column(table, apparent_size)
+    table.add_column("Disk", justify="right")
+    totals = extension_totals(root)
+    ranked = sorted(totals.items(), key=lambda item: item[1][2], reverse=True)
+    for ext, (count, size_bytes, disk) in ranked[:top_n]:
+        row: list[str] = [f".{ext}" if ext else "(none)", f"{count:,}"]
+        _append_size(row, size_bytes, apparent_size)
+        row.append(format_bytes(disk))
+        table.add_row(*row)
+    return table
+
+
 def render_summary(
     console: Console,
     root: ScanNode,
@@ -69,6 +98,8 @@ def render_summary(
     root_prefix: str,
     *,
     apparent_size: bool = False,
+    size_margin: int | None = None,
+    disk_margin: int | None = None,
 ) -> None:
     table = Table(title="Top Level Summary", header_style="bold cyan")
     table.add_column("Path")
@@ -77,19 +108,23 @@ def render_summary(
     table.add_column("Disk", justify="right")
 
     for child in sorted(root.children, key=lambda n: n.disk_usage, reverse=True):
+        # getattr: ScanTreeNode handles have no `estimated` attribute.
+        mark = "~" if getattr(child, "estimated", False) else ""
         row: list[str] = [
-            _trim(child.path, root_prefix),
+            mark + _trim(child.path, root_prefix),
             "DIR" if child.kind is NodeKind.DIRECTORY else "FILE",
         ]
         _append_size(row, child.size_bytes, apparent_size)
-        row.append(format_bytes(child.disk_usage))
+        row.append(mark + format_bytes(child.disk_usage))
         table.add_row(*row)
 
     table.add_section()
     total_row: list[str] = ["[bold]Total[/bold]", ""]
     if apparent_size:
-        total_row.append(f"[bold]{format_bytes(root.size_bytes)}[/bold]")
-    total_row.append(f"[bold]{format_bytes(root.disk_usage)}[/bold]")
+        margin = f" ±{format_bytes(size_margin)}" if size_margin is not None else ""
+        total_row.append(f"[bold]{format_bytes(root.size_bytes)}{margin}[/bold]")
+    margin = f" ±{format_bytes(disk_margin)}" if disk_margin is not None else ""
+    total_row.append(f"[bold]{format_bytes(root.disk_usage)}{margin}[/bold]")
     table.add_row(*total_row)
     table.add_section()
     extra_cols = 1 + int(apparent_size)
@@ -110,6 +145,9 @@ def render_focused_summary(
     top_cache: bool = False,
     top_dirs: bool = False,
     top_files: bool = False,
+    by_ext: bool = False,
+    top_dir_nodes: list[ScanNode] | None = None,
+    top_file_nodes: list[ScanNode] | None = None,
     apparent_size: bool = False,
 ) -> None:
     if top_temp:
@@ -130,10 +168,125 @@ def render_focused_summary(
     if top_dirs:
         console.print(
             _top_nodes_table(
-                "Largest Directories", root, top_n, NodeKind.DIRECTORY, root_prefix, apparent_size=apparent_size
+                "Largest Directories",
+                root,
+                top_n,
+                NodeKind.DIRECTORY,
+                root_prefix,
+                nodes=top_dir_nodes,
+                apparent_size=apparent_size,
             )
         )
     if top_files:
         console.print(
-            _top_nodes_table("Largest Files", root, top_n, NodeKind.FILE, root_prefix, apparent_size=apparent_size)
+            _top_nodes_table(
+                "Largest Files",
+                root,
+                top_n,
+                NodeKind.FILE,
+                root_prefix,
+                nodes=top_file_nodes,
+                apparent_size=apparent_size,
+            )
+        )
+    if by_ext:
+        console.print(_extension_table(root, top_n, apparent_size=apparent_size))
+
+
+def render_duplicates(
+    console: Console,
+    groups: list[DuplicateGroup],
+    top_n: int,
+    root_prefix: str,
+) -> None:
+    """Print confirmed duplicate groups, biggest reclaim first.
+
+    *groups* comes pre-sorted from ``find_duplicates``; this shows the
+    top *top_n* groups (one row per copy) plus a total over all groups.
+    """
+    if not groups:
+        console.print("[#b5bd68]No duplicate files found.[/]")
+        return
+
+    table = Table(title="Duplicate Files", header_style="bold cyan")
+    table.add_column("Path")
+    table.add_column("Copies", justify="right")
+    table.add_column("Size", justify="right")
+    table.add_column("Reclaimable", justify="right")
+
+    for group in groups[:top_n]:
+        first, *rest = group.paths
+        table.add_row(
+            _trim(first, root_prefix),
+            str(len(group.paths)),
+            format_bytes(group.size_bytes),
+            format_bytes(group.reclaimable),
         )
+        for path in rest:
+            table.add_row(f"[#969896]= {_trim(path, root_prefix)}[/]", "", "", "")
+
+    total = sum(g.reclaimable for g in groups)
+    table.add_section()
+    table.add_row(
+        f"[bold]Total ({len(groups)} groups)[/bold]",
+        "",
+        "",
+        f"[bold]{format_bytes(total)}[/bold]",
+    )
+    console.print(table)
+
+
+_DIFF_STATUS_STYLE = {
+    DiffStatus.ADDED: "[green]added[/green]",
+    DiffStatus.REMOVED: "[red]removed[/red]",
+    DiffStatus.CHANGED: "[yellow]changed[/yellow]",
+}
+
+
+def render_diff(
+    console: Console,
+    entries: list[DiffEntry],
+    top_n: int,
+    root_prefix: str,
+) -> None:
+    """Print the biggest movers between two snapshots.
+
+    *entries* comes pre-sorted from ``diff_snapshots`` (absolute disk
+    delta descending, root summary included); this shows the top *top_n*
+    plus a total row.
+    """
+    root = next((e for e in entries if e.path.rstrip("/") + "/" == root_prefix), None)
+
+    table = Table(title="Snapshot Diff — Biggest Movers", header_style="bold cyan")
+    table.add_column("Path")
+    table.add_column("Type", justify="center")
+    table.add_column("Status", justify="center")
+    table.add_column("Δ Disk", justify="right")
+    table.add_column("Nodes ±", justify="right")
+
+    shown = 0
+    for entry in entries:
+        if root is not None and entry is root:
+            continue
+        if shown >= top_n:
+            break
+        table.add_row(
+            _trim(entry.path, root_prefix),
+            "DIR" if entry.is_dir else "FILE",
+            _DIFF_STATUS_STYLE[entry.status],
+            format_delta(entry.delta_disk),
+            f"+{entry.nodes_added:,}/-{entry.nodes_removed:,}",
+        )
+        shown += 1
+
+    if root is not None:
+        table.add_section()
+        table.add_row(
+            "[bold]Total[/bold]",
+            "",
+            "",
+            f"[bold]{format_delta(root.delta_disk)}[/bold]",
+            f"[bold]+{root.nodes_added:,}/-{root.nodes_removed:,}[/bold]",
+        )
+
+    console.print(table)
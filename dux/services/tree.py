@@ -1,8 +1,10 @@
 from __future__ import annotations
 
 import heapq
+import threading
 from collections.abc import Iterator
 
+from dux._walker import TopN
 from dux.models.enums import NodeKind
 from dux.models.scan import ScanNode
 
@@ -11,8 +13,13 @@ from dux.models.scan import ScanNode
 LEAF_CHILDREN: tuple[()] = ()
 
 
-def finalize_sizes(root: ScanNode) -> None:
-    """Bottom-up pass: sum children sizes into directory nodes and sort by disk_usage."""
+def finalize_sizes(root: ScanNode, top_dirs: TopN | None = None) -> None:
+    """Bottom-up pass: sum children sizes into directory nodes and sort by disk_usage.
+
+    With *top_dirs*, every directory (including *root*) is offered to the
+    collector once its size is final — directory sizes only exist here,
+    so this is the earliest a streaming largest-dirs list can be fed.
+    """
     # Two-pass iterative approach (avoids recursion on deep trees):
     #   Pass 1: DFS collects directory nodes in pre-order into `stack`.
     #   Pass 2: reversed(stack) gives post-order (leaves before parents),
@@ -29,6 +36,146 @@ def finalize_sizes(root: ScanNode) -> None:
         node.size_bytes = sum(child.size_bytes for child in node.children)
         node.disk_usage = sum(child.disk_usage for child in node.children)
         node.children.sort(key=lambda x: x.disk_usage, reverse=True)
+        if top_dirs is not None:
+            top_dirs.push(node.disk_usage, node)
+
+
+def finalize_sizes_parallel(root: ScanNode, workers: int = 4, top_dirs: TopN | None = None) -> None:
+    """Finalize with *workers* threads, partitioned at the root's children.
+
+    Top-level child directories are independent subtrees, so each can be
+    finalized concurrently; only the final aggregation and sort at the root
+    needs all of them done.  After an N-worker scan this keeps the cores
+    busy through the finalize phase too (most effective on free-threaded
+    builds, where the aggregation really runs in parallel).
+    """
+    subtrees = [child for child in root.children if child.is_dir and child.children]
+    if workers <= 1 or len(subtrees) < 2:
+        finalize_sizes(root, top_dirs)
+        return
+
+    # Hand out subtrees via a shared iterator: sizes are unknown before
+    # aggregation, so static partitioning could load one worker with all
+    # the big directories.
+    it = iter(subtrees)
+    lock = threading.Lock()
+
+    def run_worker() -> None:
+        while True:
+            with lock:
+                subtree = next(it, None)
+            if subtree is None:
+                return
+            finalize_sizes(subtree, top_dirs)
+
+    threads = [
+        threading.Thread(target=run_worker, daemon=True)
+        for _ in range(min(workers, len(subtrees)))
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    # Combine at the root (its direct files need no per-node work).
+    root.size_bytes = sum(child.size_bytes for child in root.children)
+    root.disk_usage = sum(child.disk_usage for child in root.children)
+    root.children.sort(key=lambda x: x.disk_usage, reverse=True)
+    if top_dirs is not None:
+        # The workers covered the subtrees; the root and its empty child
+        # dirs (no subtree of their own) are offered here.
+        for child in root.children:
+            if child.is_dir and not child.children:
+                top_dirs.push(child.disk_usage, child)
+        top_dirs.push(root.disk_usage, root)
+
+
+def extrapolate_estimates(root: ScanNode) -> tuple[int, int]:
+    """Fill in sampled-out directories after an estimation-mode scan.
+
+    Runs after ``finalize_sizes``: every scanned subtree already carries
+    exact totals, while directories skipped by sampling sit at 0 with
+    ``estimated`` set.  Each such hole is assigned the mean subtree size
+    of its scanned sibling directories, the delta is propagated up the
+    ancestors (whose sibling lists are re-sorted to keep the finalize
+    invariant), and every ancestor of a hole is flagged ``estimated`` so
+    the UI can mark the whole affected lineage.
+
+    Returns ``(size_margin, disk_margin)``: the half-width of a ~95%
+    confidence interval on the root totals, from the sample variance of
+    the scanned siblings at each sampling site.  A site whose sample has
+    no spread — including every sample of one — contributes zero, so
+    small-sample margins understate the true uncertainty.
+    """
+    # Same two-pass shape as finalize_sizes: pre-order collect, reversed
+    # gives post-order, so a hole's scanned siblings are final (and
+    # already extrapolated below themselves) before their mean is taken.
+    stack: list[ScanNode] = []
+    visit: list[ScanNode] = [root]
+    while visit:
+        node = visit.pop()
+        if not node.is_dir:
+            continue
+        stack.append(node)
+        visit.extend(node.children)
+
+    # Per-node deltas and variances, keyed by id(); only touched lineages
+    # get entries, so an exact region of the tree costs nothing here.
+    deltas: dict[int, tuple[int, int]] = {}
+    variances: dict[int, tuple[float, float]] = {}
+    for node in reversed(stack):
+        d_size = d_disk = 0
+        v_size = v_disk = 0.0
+        holes: list[ScanNode] = []
+        sampled_sizes: list[int] = []
+        sampled_disks: list[int] = []
+        for child in node.children:
+            child_delta = deltas.get(id(child))
+            if child_delta is not None:
+                d_size += child_delta[0]
+                d_disk += child_delta[1]
+                cv = variances.get(id(child))
+                if cv is not None:
+                    v_size += cv[0]
+                    v_disk += cv[1]
+            if not child.is_dir:
+                continue
+            if child.estimated and not child.children and child.size_bytes == 0:
+                holes.append(child)
+            elif not child.estimated or child.children:
+                sampled_sizes.append(child.size_bytes)
+                sampled_disks.append(child.disk_usage)
+
+        if holes and sampled_sizes:
+            k = len(sampled_sizes)
+            mean_size = sum(sampled_sizes) // k
+            mean_disk = sum(sampled_disks) // k
+            # Unbiased sample variance; each hole's estimate carries the
+            # sibling spread plus the mean's own error (the 1/k term).
+            if k > 1:
+                ms = sum(sampled_sizes) / k
+                md = sum(sampled_disks) / k
+                s2_size = sum((x - ms) ** 2 for x in sampled_sizes) / (k - 1)
+                s2_disk = sum((x - md) ** 2 for x in sampled_disks) / (k - 1)
+                v_size += len(holes) * s2_size * (1 + 1 / k)
+                v_disk += len(holes) * s2_disk * (1 + 1 / k)
+            for hole in holes:
+                hole.size_bytes = mean_size
+                hole.disk_usage = mean_disk
+                d_size += mean_size
+                d_disk += mean_disk
+
+        if d_size or d_disk or v_size or v_disk:
+            node.size_bytes += d_size
+            node.disk_usage += d_disk
+            node.children.sort(key=lambda x: x.disk_usage, reverse=True)
+            node.estimated = True
+            deltas[id(node)] = (d_size, d_disk)
+            if v_size or v_disk:
+                variances[id(node)] = (v_size, v_disk)
+
+    root_var = variances.get(id(root), (0.0, 0.0))
+    return int(1.96 * root_var[0] ** 0.5), int(1.96 * root_var[1] ** 0.5)
 
 
 def iter_nodes(root: ScanNode) -> Iterator[ScanNode]:
@@ -40,6 +187,35 @@ def iter_nodes(root: ScanNode) -> Iterator[ScanNode]:
         stack.extend(node.children)
 
 
+def extension_totals(root: ScanNode) -> dict[str, tuple[int, int, int]]:
+    """Aggregate files by lowercased extension: ext -> (count, size, disk).
+
+    Files without an extension (no dot, hidden-file leading dot, or a
+    trailing dot) are grouped under ``""``.  ScanTree-backed roots expose
+    the owning tree on their handles, so those dispatch to the native
+    ``by_extension`` kernel — one GIL-free sweep over the flat arrays
+    instead of a per-node interpreted pass.
+    """
+    tree = getattr(root, "tree", None)
+    if tree is not None:
+        return tree.by_extension()  # type: ignore[no-any-return]
+
+    totals: dict[str, list[int]] = {}
+    for node in iter_nodes(root):
+        if node.is_dir:
+            continue
+        dot = node.name.rfind(".")
+        ext = node.name[dot + 1 :].lower() if 0 < dot < len(node.name) - 1 else ""
+        acc = totals.get(ext)
+        if acc is None:
+            totals[ext] = [1, node.size_bytes, node.disk_usage]
+        else:
+            acc[0] += 1
+            acc[1] += node.size_bytes
+            acc[2] += node.disk_usage
+    return {ext: (c, s, d) for ext, (c, s, d) in totals.items()}
+
+
 def top_nodes(root: ScanNode, n: int, kind: NodeKind | None = None) -> list[ScanNode]:
     """Return the *n* largest nodes, excluding *root*.
 
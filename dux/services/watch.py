@@ -0,0 +1,221 @@
+from __future__ import annotations
+
+from dux._fswatch import OVERFLOW, Watcher
+from dux.models.scan import ScanNode, ScanStats
+from dux.services.fs import DEFAULT_FS, FileSystem
+from dux.services.tree import iter_nodes
+
+
+class WatchService:
+    """Keep a finalized scan tree current from filesystem events.
+
+    After the initial scan, every directory in the tree gets an inotify
+    watch (via ``dux._fswatch``).  ``poll`` drains the coalesced
+    dirty-directory batch, rescans only those directories — one scandir
+    each — and patches the size deltas up the ancestor chain, so a
+    touched directory costs its own listing plus O(depth) updates
+    instead of a global rescan and finalize pass.
+
+    New directories are scanned and watched as they appear; removed
+    subtrees are unwatched and subtracted from the stats.  Scope notes:
+    hardlink dedup and one-filesystem accounting from the initial scan
+    are not re-applied to incremental updates, and insights are not
+    recomputed — watch mode keeps sizes and structure current, category
+    labels stay as of the initial scan.
+
+    Raises OSError at construction where inotify is unavailable
+    (non-Linux); callers degrade to the usual static snapshot.
+    """
+
+    def __init__(
+        self,
+        root: ScanNode,
+        stats: ScanStats,
+        fs: FileSystem = DEFAULT_FS,
+        prune_dirs: frozenset[str] | None = None,
+    ) -> None:
+        self.root = root
+        self.stats = stats
+        self._fs = fs
+        self._prune_dirs = prune_dirs
+        self._watcher = Watcher()
+        self._dir_nodes: dict[int, ScanNode] = {}  # wd -> directory node
+        self._wd_by_path: dict[str, int] = {}
+        for node in iter_nodes(root):
+            if node.is_dir and not node.unexpanded:
+                self._watch(node)
+
+    def close(self) -> None:
+        self._watcher.close()
+
+    def poll(self, timeout_ms: int = 0) -> list[str]:
+        """Process pending events; returns the refreshed directory paths.
+
+        An empty list means nothing changed.  On kernel queue overflow
+        (events were dropped) every watched directory is treated as
+        dirty — correct, just not incremental for that one batch.
+        """
+        wds = self._watcher.poll(timeout_ms)
+        if not wds:
+            return []
+        if OVERFLOW in wds:
+            nodes = list(self._dir_nodes.values())
+        else:
+            nodes = [self._dir_nodes[wd] for wd in wds if wd in self._dir_nodes]
+
+        changed: list[str] = []
+        for node in nodes:
+            # A dirty batch can contain a directory that an earlier
+            # refresh in the same batch already detached (its parent
+            # was dirty too); skip those.
+            if not self._attached(node):
+                continue
+            if self._refresh_dir(node):
+                changed.append(node.path)
+        return changed
+
+    # -- incremental refresh ------------------------------------------------
+
+    def _refresh_dir(self, node: ScanNode) -> bool:
+        """Rescan one directory level and patch deltas up the ancestors."""
+        try:
+            entries = list(self._fs.scandir(node.path))
+        except OSError:
+            # Directory vanished; its parent's refresh removes the node.
+            return False
+
+        old = {child.name: child for child in node.children}
+        new_children: list[ScanNode] = []
+        errors = 0
+        changed = False
+        for entry in entries:
+            st = entry.stat
+            if st is None:
+                errors += 1
+                continue
+            prev = old.pop(entry.name, None)
+            if st.is_dir:
+                if prev is not None and prev.is_dir:
+                    new_children.append(prev)
+                    continue
+                if prev is not None:  # file replaced by a directory
+                    self.stats.files -= 1
+                child = ScanNode.directory(entry.name, parent=node)
+                self.stats.directories += 1
+                self._scan_new_subtree(child)
+                new_children.append(child)
+                changed = True
+            else:
+                if (
+                    prev is not None
+                    and not prev.is_dir
+                    and prev.size_bytes == st.size
+                    and prev.disk_usage == st.disk_usage
+                ):
+                    new_children.append(prev)
+                    continue
+                if prev is None:
+                    self.stats.files += 1
+                elif prev.is_dir:  # directory replaced by a file
+                    self._drop_subtree(prev)
+                    self.stats.files += 1
+                new_children.append(ScanNode.file(entry.name, st.size, st.disk_usage, parent=node))
+                changed = True
+        for leftover in old.values():
+            self._drop_subtree(leftover)
+            changed = True
+
+        if errors:
+            self.stats.access_errors += errors
+        if not changed:
+            return False
+
+        new_children.sort(key=lambda c: c.disk_usage, reverse=True)
+        node.children = new_children
+        delta_size = sum(c.size_bytes for c in new_children) - node.size_bytes
+        delta_disk = sum(c.disk_usage for c in new_children) - node.disk_usage
+        self._propagate(node, delta_size, delta_disk)
+        return True
+
+    def _scan_new_subtree(self, node: ScanNode) -> None:
+        """Full scan of a directory that appeared after the initial scan."""
+        if self._prune_dirs is not None and node.name.lower() in self._prune_dirs:
+            node.unexpanded = True
+            return
+        self._watch(node)
+        try:
+            entries = list(self._fs.scandir(node.path))
+        except OSError:
+            self.stats.access_errors += 1
+            return
+        size = disk = 0
+        for entry in entries:
+            st = entry.stat
+            if st is None:
+                self.stats.access_errors += 1
+                continue
+            if st.is_dir:
+                child = ScanNode.directory(entry.name, parent=node)
+                self.stats.directories += 1
+                self._scan_new_subtree(child)
+            else:
+                child = ScanNode.file(entry.name, st.size, st.disk_usage, parent=node)
+                self.stats.files += 1
+            node.children.append(child)
+            size += child.size_bytes
+            disk += child.disk_usage
+        node.children.sort(key=lambda c: c.disk_usage, reverse=True)
+        node.size_bytes = size
+        node.disk_usage = disk
+
+    def _drop_subtree(self, node: ScanNode) -> None:
+        """Unwatch a removed subtree and subtract it from the stats."""
+        if not node.is_dir:
+            self.stats.files -= 1
+            return
+        for n in iter_nodes(node):
+            if n.is_dir:
+                self.stats.directories -= 1
+                self._unwatch(n)
+            else:
+                self.stats.files -= 1
+
+    def _propagate(self, node: ScanNode, delta_size: int, delta_disk: int) -> None:
+        """Apply a size delta to *node* and every ancestor, keeping each
+        ancestor's children sorted by disk usage (finalize invariant)."""
+        node.size_bytes += delta_size
+        node.disk_usage += delta_disk
+        cur = node.parent
+        while cur is not None:
+            cur.size_bytes += delta_size
+            cur.disk_usage += delta_disk
+            cur.children.sort(key=lambda c: c.disk_usage, reverse=True)
+            cur = cur.parent
+
+    # -- watch bookkeeping --------------------------------------------------
+
+    def _watch(self, node: ScanNode) -> None:
+        # Watch-limit exhaustion (ENOSPC) or a directory racing away
+        # (ENOENT) leaves the subtree unwatched but the tree intact.
+        try:
+            wd = self._watcher.add(node.path)
+        except OSError:
+            return
+        self._dir_nodes[wd] = node
+        self._wd_by_path[node.path] = wd
+
+    def _unwatch(self, node: ScanNode) -> None:
+        wd = self._wd_by_path.pop(node.path, None)
+        if wd is None:
+            return
+        self._dir_nodes.pop(wd, None)
+        try:
+            self._watcher.remove(wd)
+        except OSError:
+            pass
+
+    def _attached(self, node: ScanNode) -> bool:
+        cur = node
+        while cur.parent is not None:
+            cur = cur.parent
+        return cur is self.root
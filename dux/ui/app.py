@@ -19,6 +19,7 @@ from dux.models.enums import InsightCategory, NodeKind
 from dux.models.insight import CategoryStats, InsightBundle
 from dux.models.scan import ScanNode, ScanStats
 from dux.services.formatting import format_bytes, relative_bar
+from dux.services.watch import WatchService
 from dux.ui.views import (
     DisplayRow,
     browse_rows,
@@ -232,6 +233,7 @@ class DuxApp(App[None]):
         config: AppConfig,
         initial_view: str = "overview",
         apparent_size: bool = False,
+        watch: WatchService | None = None,
     ) -> None:
         super().__init__()
         self.root = root
@@ -239,6 +241,7 @@ class DuxApp(App[None]):
         self.bundle = bundle
         self.config = config
         self._apparent_size = apparent_size
+        self._watch = watch
         self.current_view = initial_view if initial_view in TABS else "overview"
 
         self._page_size = config.page_size
@@ -288,11 +291,33 @@ class DuxApp(App[None]):
         table.cursor_type = "row"
         table.zebra_stripes = True
         table.focus()
+        if self._watch is not None:
+            self.set_interval(1.0, self._poll_watch)
         self._refresh_all()
 
     def on_resize(self) -> None:
         self._refresh_all()
 
+    def _poll_watch(self) -> None:
+        """Watch-mode tick: fold coalesced filesystem events into the view.
+
+        WatchService has already rescanned the dirty directories and
+        patched sizes up the ancestor chains; here we just rebuild the
+        path index (nodes may have appeared, moved or gone) and drop
+        every row cache so the next render reflects the updated tree.
+        """
+        assert self._watch is not None
+        if not self._watch.poll(0):
+            return
+        self.node_by_path.clear()
+        self.parent_by_path.clear()
+        self._index_tree(self.root)
+        if self.browse_root_path not in self.node_by_path:
+            self.browse_root_path = self.root.path
+        for view in TABS:
+            self._invalidate_rows(view)
+        self._refresh_all()
+
     def _refresh_all(self) -> None:
         self._render_header_rows()
         self._render_content_table()
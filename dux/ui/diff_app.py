@@ -0,0 +1,60 @@
+# Minimal TUI for browsing a snapshot diff.
+#
+# Diff mode has no live tree, insights, or browse state, so it gets its
+# own small app rather than another DuxApp tab: one DataTable of movers
+# (pre-sorted by absolute disk delta), scrollable with the standard
+# DataTable keys.
+
+from __future__ import annotations
+
+from typing import override
+
+from rich.text import Text
+from textual.app import App, ComposeResult
+from textual.widgets import DataTable, Static
+
+from dux.models.enums import DiffStatus
+from dux.services.diff import DiffEntry
+from dux.services.formatting import format_delta, relative_path
+
+_STATUS_COLOR = {
+    DiffStatus.ADDED: "#b5bd68",
+    DiffStatus.REMOVED: "#cc6666",
+    DiffStatus.CHANGED: "#f0c674",
+}
+
+
+class DiffApp(App[None]):
+    """Scrollable table of per-subtree deltas between two snapshots."""
+
+    def __init__(self, entries: list[DiffEntry], root_prefix: str) -> None:
+        super().__init__()
+        self._entries = entries
+        self._root_prefix = root_prefix
+
+    @override
+    def compose(self) -> ComposeResult:
+        yield Static(f"dux diff — {self._root_prefix}  (q to quit)", id="diff-title")
+        yield DataTable(id="diff-table")
+
+    def on_mount(self) -> None:
+        table = self.query_one("#diff-table", DataTable)
+        table.cursor_type = "row"
+        table.zebra_stripes = True
+        table.add_column("PATH")
+        table.add_column("TYPE")
+        table.add_column("STATUS")
+        table.add_column("Δ DISK")
+        table.add_column("NODES ±")
+        for entry in self._entries:
+            table.add_row(
+                relative_path(entry.path, self._root_prefix) or entry.path,
+                "DIR" if entry.is_dir else "FILE",
+                Text(entry.status.value, style=_STATUS_COLOR[entry.status]),
+                Text(format_delta(entry.delta_disk), justify="right"),
+                Text(f"+{entry.nodes_added:,}/-{entry.nodes_removed:,}", justify="right"),
+            )
+        table.focus()
+
+    def key_q(self) -> None:
+        self.exit()
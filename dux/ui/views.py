@@ -61,14 +61,41 @@ def overview_rows(
         rows.append(
             DisplayRow(
                 path=node.path,
-                name=relative_path(node.path, root_prefix),
+                name=_estimate_mark(node) + relative_path(node.path, root_prefix),
                 size_bytes=node.size_bytes,
                 disk_usage=node.disk_usage,
             )
         )
+
+    # Debug pane for --prof scans: where the scan time went (walker I/O
+    # vs GIL wait vs node building, scheduler behaviour, finalize).
+    if stats.profile is not None:
+        p = stats.profile
+        rows.append(DisplayRow(path="", name="─────── Scan profile (--prof) ───────", size_bytes=0))
+        rows.extend(
+            DisplayRow(path="", name=line, size_bytes=0)
+            for line in (
+                f"Wall: {p['wall_s']:.2f}s  ({p['entries_per_s']:,.0f} entries/s)",
+                f"Walker I/O: {p['walker_io_s']:.2f}s   GIL wait: {p['walker_gil_wait_s']:.2f}s"
+                f"   Node build: {p['walker_build_s']:.2f}s  (summed over workers,"
+                f" {p['walker_calls']:,.0f} calls)",
+                f"Queue: {p['queue_steals']:,.0f} steals, {p['queue_parks']:,.0f} parks"
+                f" ({p['queue_park_s']:.2f}s parked)",
+                f"Finalize: {p['finalize_s']:.2f}s",
+            )
+        )
     return rows
 
 
+def _estimate_mark(node: ScanNode) -> str:
+    """'~' prefix for extrapolated sizes (estimation-mode scans).
+
+    getattr because ScanTreeNode handles duck-type ScanNode without this
+    attribute (the compact scanner never samples).
+    """
+    return "~" if getattr(node, "estimated", False) else ""
+
+
 def browse_rows(
     browse_root: ScanNode,
     expanded: set[str],
@@ -79,7 +106,7 @@ def browse_rows(
         node, depth = stack.pop()
         if node.kind is NodeKind.DIRECTORY:
             marker = "▼" if node.path in expanded else "▶"
-            label = f"{'  ' * depth}{marker} {node.name}"
+            label = f"{'  ' * depth}{marker} {_estimate_mark(node)}{node.name}"
         else:
             label = f"{'  ' * depth}  {node.name}"
         rows.append(
@@ -132,7 +159,7 @@ def top_nodes_rows(
         rows.append(
             DisplayRow(
                 path=node.path,
-                name=relative_path(node.path, root_prefix),
+                name=_estimate_mark(node) + relative_path(node.path, root_prefix),
                 size_bytes=node.size_bytes,
                 disk_usage=node.disk_usage,
             )
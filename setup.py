@@ -23,11 +23,41 @@ setup(
             extra_compile_args=_common_flags,
             extra_link_args=["-flto"],
         ),
+        Extension(
+            "dux._atomic_stats",
+            sources=["csrc/atomic_stats.c"],
+            extra_compile_args=_common_flags,
+            extra_link_args=["-flto"],
+        ),
+        Extension(
+            "dux._scan_tree",
+            sources=["csrc/scan_tree.c"],
+            extra_compile_args=_common_flags,
+            extra_link_args=["-flto"],
+        ),
+        Extension(
+            "dux._ruleset",
+            sources=["csrc/ruleset.c"],
+            extra_compile_args=_common_flags,
+            extra_link_args=["-flto"],
+        ),
         Extension(
             "dux._prefix_trie",
             sources=["csrc/prefix_trie.c"],
             extra_compile_args=_common_flags,
             extra_link_args=["-flto"],
         ),
+        Extension(
+            "dux._fswatch",
+            sources=["csrc/fswatch.c"],
+            extra_compile_args=_common_flags,
+            extra_link_args=["-flto"],
+        ),
+        Extension(
+            "dux._hasher",
+            sources=["csrc/hasher.c"],
+            extra_compile_args=_common_flags,
+            extra_link_args=["-flto"],
+        ),
     ]
 )
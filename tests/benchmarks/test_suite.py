@@ -0,0 +1,73 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from benchmarks.suite import bench_ac, bench_finalize, bench_prefix_trie, bench_walkers
+from benchmarks.synth import PROFILES, generate, path_corpus
+
+
+def test_generate_is_deterministic(tmp_path: Path) -> None:
+    a = tmp_path / "a"
+    b = tmp_path / "b"
+    a.mkdir()
+    b.mkdir()
+    stats_a = generate("many-small", str(a), scale=0.05)
+    stats_b = generate("many-small", str(b), scale=0.05)
+
+    assert stats_a == stats_b
+    listing = lambda root: sorted(str(p.relative_to(root)) for p in root.rglob("*"))  # noqa: E731
+    assert listing(a) == listing(b)
+
+
+def test_generate_counts_match_tree(tmp_path: Path) -> None:
+    stats = generate("hardlink-heavy", str(tmp_path), scale=0.05)
+
+    files = sum(1 for p in tmp_path.rglob("*") if p.is_file())
+    dirs = sum(1 for p in tmp_path.rglob("*") if p.is_dir())
+    assert stats.files == files
+    assert stats.directories == dirs
+
+
+def test_generate_rejects_unknown_profile(tmp_path: Path) -> None:
+    with pytest.raises(ValueError, match="unknown profile"):
+        generate("bogus", str(tmp_path))
+
+
+def test_path_corpus_deterministic_and_absolute() -> None:
+    first = path_corpus(50)
+    second = path_corpus(50)
+
+    assert first == second
+    assert all(p.startswith("/") for p in first)
+
+
+def test_cases_report_sane_throughput(tmp_path: Path) -> None:
+    # Smoke-run each case family at toy scale: correctness of the
+    # accounting, not the numbers, is what a unit test can pin down.
+    generate("wide", str(tmp_path), scale=0.05)
+    for result in bench_walkers(str(tmp_path), repeats=1):
+        assert result.entries > 0
+        assert result.eps > 0
+
+    results = list(bench_ac(200, repeats=1)) + list(bench_prefix_trie(200, repeats=1))
+    assert {r.name for r in results} == {
+        "matcher/ac_iter",
+        "matcher/ac_iter_many",
+        "matcher/prefix_trie_iter",
+    }
+    assert all(r.entries == 200 for r in results)
+
+    (finalize_result,) = bench_finalize(scale=0.1, repeats=1)
+    assert finalize_result.entries > 0
+    assert finalize_result.seconds >= 0
+
+
+def test_all_profiles_generate(tmp_path: Path) -> None:
+    for profile in PROFILES:
+        root = tmp_path / profile
+        root.mkdir()
+        stats = generate(profile, str(root), scale=0.02)
+        assert stats.files > 0
+        assert stats.directories > 0
@@ -2,18 +2,30 @@ from __future__ import annotations
 
 from dux.models.scan import ScanNode
 
+# Nodes store parent-relative names plus a parent reference; a parentless
+# node's name is its full path.  The factories take full paths for
+# convenience: a freshly made node anchors at its own path, and attaching
+# children rewrites their names relative to the parent so the lazily-joined
+# ``path`` round-trips (tests often attach e.g. "/root/.cache/pip" directly
+# under "/root", so the relative name may span several components).
+
 
 def make_file(path: str, du: int = 0) -> ScanNode:
-    name = path.rsplit("/", 1)[-1]
-    node = ScanNode.file(path, name, du, du)
+    node = ScanNode.file(path, du, du)
     return node
 
 
 def make_dir(path: str, du: int = 0, children: list[ScanNode] | None = None) -> ScanNode:
-    name = path.rsplit("/", 1)[-1]
-    node = ScanNode.directory(path, name)
+    node = ScanNode.directory(path)
     node.size_bytes = du
     node.disk_usage = du
     if children:
+        prefix = path.rstrip("/") + "/"
+        for child in children:
+            if child.name.startswith(prefix):
+                child.name = child.name[len(prefix) :]
+            else:
+                child.name = child.name.rsplit("/", 1)[-1]
+            child.parent = node
         node.children = children
     return node
@@ -12,14 +12,15 @@ class _MockEntry:
     size: int
     content: str
     disk_usage: int = 0
+    dev: int = 1  # fake device id; override to simulate mount points
 
 
 class MemoryFileSystem:
     def __init__(self) -> None:
         self._entries: dict[str, _MockEntry] = {}
 
-    def add_dir(self, path: str) -> MemoryFileSystem:
-        self._entries[self._normalize(path)] = _MockEntry(is_dir=True, size=0, content="")
+    def add_dir(self, path: str, dev: int = 1) -> MemoryFileSystem:
+        self._entries[self._normalize(path)] = _MockEntry(is_dir=True, size=0, content="", dev=dev)
         return self
 
     def add_file(
@@ -57,7 +58,7 @@ class MemoryFileSystem:
         entry = self._entries.get(key)
         if entry is None:
             raise OSError(f"No such file or directory: '{key}'")
-        return StatResult(size=entry.size, is_dir=entry.is_dir, disk_usage=entry.disk_usage)
+        return StatResult(size=entry.size, is_dir=entry.is_dir, disk_usage=entry.disk_usage, dev=entry.dev)
 
     def read_text(self, path: str, encoding: str = "utf-8") -> str:
         key = self._normalize(path)
@@ -92,6 +93,7 @@ class MemoryFileSystem:
                         size=child_entry.size,
                         is_dir=child_entry.is_dir,
                         disk_usage=child_entry.disk_usage,
+                        dev=child_entry.dev,
                     )
                     if child_entry is not None
                     else None
@@ -60,3 +60,75 @@ class TestScanDirError:
         result = scanner.scan("/root", ScanOptions())
         snapshot = result.unwrap()
         assert snapshot.stats.access_errors >= 1
+
+
+class TestWorkStealingQueue:
+    def test_local_pop_is_lifo(self) -> None:
+        from dux.scan._base import _Task, _WorkStealingQueue
+
+        q = _WorkStealingQueue(2)
+        a = _Task(ScanNode.directory("/a"), 0)
+        b = _Task(ScanNode.directory("/b"), 0)
+        q.put(a, worker_id=0)
+        q.put(b, worker_id=0)
+
+        assert q.get(0) is b
+        assert q.get(0) is a
+
+    def test_steals_oldest_from_victim(self) -> None:
+        from dux.scan._base import _Task, _WorkStealingQueue
+
+        q = _WorkStealingQueue(2)
+        a = _Task(ScanNode.directory("/a"), 0)
+        b = _Task(ScanNode.directory("/b"), 0)
+        q.put_many([a, b], worker_id=0)
+
+        # Worker 1 has nothing local, so it steals worker 0's oldest task.
+        assert q.get(1) is a
+
+    def test_join_completes_after_all_tasks_done(self) -> None:
+        from dux.scan._base import _Task, _WorkStealingQueue
+
+        q = _WorkStealingQueue(1)
+        q.put(_Task(ScanNode.directory("/a"), 0))
+        task = q.get(0)
+        assert task is not None
+        q.task_done()
+        q.join()  # must not block
+
+    def test_shutdown_unblocks_get(self) -> None:
+        from dux.scan._base import _WorkStealingQueue
+
+        q = _WorkStealingQueue(1)
+        q.shutdown()
+        assert q.get(0) is None
+
+
+class TestAtomicStats:
+    def test_add_and_snapshot(self) -> None:
+        from dux._atomic_stats import AtomicStats
+
+        stats = AtomicStats()
+        assert stats.snapshot() == (0, 0, 0)
+        stats.add(3, 2, 1)
+        stats.add(1, 0, 0)
+        assert stats.snapshot() == (4, 2, 1)
+
+    def test_concurrent_adds_are_not_lost(self) -> None:
+        import threading
+
+        from dux._atomic_stats import AtomicStats
+
+        stats = AtomicStats()
+
+        def hammer() -> None:
+            for _ in range(10_000):
+                stats.add(1, 1, 0)
+
+        threads = [threading.Thread(target=hammer) for _ in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        assert stats.snapshot() == (80_000, 80_000, 0)
@@ -23,6 +23,12 @@ def _macos_scanner(workers: int = 4) -> NativeScanner:
     return NativeScanner(scan_dir_bulk_nodes, workers=workers)
 
 
+def _linux_scanner(workers: int = 4) -> NativeScanner:
+    from dux._walker import scan_dir_statx_nodes
+
+    return NativeScanner(scan_dir_statx_nodes, workers=workers)
+
+
 def test_posix_scanner_basic() -> None:
     with tempfile.TemporaryDirectory() as tmpdir:
         os.makedirs(os.path.join(tmpdir, "sub"))
@@ -87,3 +93,248 @@ def test_macos_scanner_max_depth() -> None:
         snapshot = result.unwrap()
         lvl1 = next(c for c in snapshot.root.children if c.name == "lvl1")
         assert lvl1.children == []
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_linux_scanner_basic() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        result = _linux_scanner().scan(tmpdir, ScanOptions())
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.stats.files == 2
+        assert snapshot.stats.directories >= 2
+        assert snapshot.root.size_bytes == 300
+        assert snapshot.root.path == tmpdir
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_linux_scanner_max_depth() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "lvl1", "lvl2"))
+        with open(os.path.join(tmpdir, "lvl1", "lvl2", "deep.txt"), "wb") as f:
+            f.write(b"z" * 50)
+
+        result = _linux_scanner().scan(tmpdir, ScanOptions(max_depth=0))
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        lvl1 = next(c for c in snapshot.root.children if c.name == "lvl1")
+        assert lvl1.children == []
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_linux_scanner_matches_posix_scanner() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "a", "b"))
+        for idx in range(5):
+            with open(os.path.join(tmpdir, "a", f"f{idx}.bin"), "wb") as f:
+                f.write(b"x" * (idx * 100))
+
+        statx_result = _linux_scanner(workers=1).scan(tmpdir, ScanOptions())
+        readdir_result = _posix_scanner(workers=1).scan(tmpdir, ScanOptions())
+
+        assert isinstance(statx_result, Ok)
+        assert isinstance(readdir_result, Ok)
+        sx, rd = statx_result.unwrap(), readdir_result.unwrap()
+        assert sx.stats.files == rd.stats.files
+        assert sx.stats.directories == rd.stats.directories
+        assert sx.root.size_bytes == rd.root.size_bytes
+        assert sx.root.disk_usage == rd.root.disk_usage
+
+
+def _uring_scanner(workers: int = 4) -> NativeScanner:
+    from dux._walker import scan_dir_uring_nodes
+
+    return NativeScanner(scan_dir_uring_nodes, workers=workers)
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_uring_scanner_basic() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        result = _uring_scanner().scan(tmpdir, ScanOptions())
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.stats.files == 2
+        assert snapshot.stats.directories >= 2
+        assert snapshot.root.size_bytes == 300
+        assert snapshot.root.path == tmpdir
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_uring_scanner_matches_posix_scanner() -> None:
+    # Large enough to cross the ring's minimum-batch threshold, so the
+    # io_uring path (or its documented sync fallback) does the stats.
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "a", "b"))
+        for idx in range(40):
+            with open(os.path.join(tmpdir, "a", f"f{idx}.bin"), "wb") as f:
+                f.write(b"x" * (idx * 100))
+
+        uring_result = _uring_scanner(workers=1).scan(tmpdir, ScanOptions())
+        readdir_result = _posix_scanner(workers=1).scan(tmpdir, ScanOptions())
+
+        assert isinstance(uring_result, Ok)
+        assert isinstance(readdir_result, Ok)
+        ur, rd = uring_result.unwrap(), readdir_result.unwrap()
+        assert ur.stats.files == rd.stats.files
+        assert ur.stats.directories == rd.stats.directories
+        assert ur.root.size_bytes == rd.root.size_bytes
+        assert ur.root.disk_usage == rd.root.disk_usage
+
+
+def test_inode_set_add_and_len() -> None:
+    from dux._walker import InodeSet
+
+    iset = InodeSet()
+    assert len(iset) == 0
+    assert iset.add(1, 100) is True
+    assert iset.add(1, 100) is False
+    assert iset.add(2, 100) is True  # same inode, different device
+    assert len(iset) == 2
+
+
+def test_posix_scanner_dedup_hardlinks() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        original = os.path.join(tmpdir, "original.bin")
+        with open(original, "wb") as f:
+            f.write(b"x" * 4096)
+        os.link(original, os.path.join(tmpdir, "link1.bin"))
+        os.link(original, os.path.join(tmpdir, "link2.bin"))
+
+        plain = _posix_scanner(workers=1).scan(tmpdir, ScanOptions())
+        deduped = _posix_scanner(workers=1).scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+
+        assert isinstance(plain, Ok)
+        assert isinstance(deduped, Ok)
+        pl, dd = plain.unwrap(), deduped.unwrap()
+        # Without dedup each of the three links counts the inode again.
+        assert pl.root.size_bytes == 3 * 4096
+        assert dd.root.size_bytes == 4096
+        assert dd.root.disk_usage == pl.root.disk_usage // 3
+        # All three entries still appear in the tree, like du -a.
+        assert dd.stats.files == 3
+
+
+def test_posix_scanner_dedup_state_is_per_scan() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        original = os.path.join(tmpdir, "a.bin")
+        with open(original, "wb") as f:
+            f.write(b"x" * 1024)
+        os.link(original, os.path.join(tmpdir, "b.bin"))
+
+        scanner = _posix_scanner(workers=1)
+        first = scanner.scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+        second = scanner.scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+
+        assert isinstance(first, Ok)
+        assert isinstance(second, Ok)
+        # A stale inode set would report 0 bytes on the rescan.
+        assert second.unwrap().root.size_bytes == first.unwrap().root.size_bytes == 1024
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Linux only")
+def test_linux_scanner_dedup_matches_posix() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        original = os.path.join(tmpdir, "original.bin")
+        with open(original, "wb") as f:
+            f.write(b"x" * 2048)
+        os.link(original, os.path.join(tmpdir, "sub", "link.bin"))
+
+        statx_result = _linux_scanner(workers=1).scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+        readdir_result = _posix_scanner(workers=1).scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+
+        assert isinstance(statx_result, Ok)
+        assert isinstance(readdir_result, Ok)
+        sx, rd = statx_result.unwrap(), readdir_result.unwrap()
+        assert sx.root.size_bytes == rd.root.size_bytes == 2048
+        assert sx.root.disk_usage == rd.root.disk_usage
+
+
+def test_posix_scanner_one_filesystem_noop_on_single_device() -> None:
+    # No mounts inside a tempdir, so du -x semantics must change nothing.
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "sub", "a.txt"), "wb") as f:
+            f.write(b"x" * 300)
+
+        plain = _posix_scanner(workers=1).scan(tmpdir, ScanOptions())
+        bounded = _posix_scanner(workers=1).scan(tmpdir, ScanOptions(one_filesystem=True))
+
+        assert isinstance(plain, Ok)
+        assert isinstance(bounded, Ok)
+        pl, bd = plain.unwrap(), bounded.unwrap()
+        assert bd.stats.files == pl.stats.files
+        assert bd.stats.directories == pl.stats.directories
+        assert bd.root.size_bytes == pl.root.size_bytes
+
+
+def test_posix_scanner_prune_dirs() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "node_modules", "dep"))
+        with open(os.path.join(tmpdir, "node_modules", "dep", "huge.js"), "wb") as f:
+            f.write(b"x" * 5000)
+        with open(os.path.join(tmpdir, "keep.bin"), "wb") as f:
+            f.write(b"y" * 100)
+
+        result = _posix_scanner(workers=1).scan(
+            tmpdir, ScanOptions(prune_dirs=frozenset({"node_modules"}))
+        )
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        nm = next(c for c in snapshot.root.children if c.name == "node_modules")
+        assert nm.unexpanded
+        assert nm.children == []
+        assert snapshot.root.size_bytes == 100
+        assert snapshot.stats.files == 1
+
+
+def test_topn_push_and_result() -> None:
+    from dux._walker import TopN
+
+    heap = TopN(3)
+    assert heap.push(10, "a")
+    assert heap.push(30, "b")
+    assert heap.push(20, "c")
+    # Full: only keys beating the current minimum get in.
+    assert not heap.push(5, "too small")
+    assert heap.push(25, "d")
+    assert len(heap) == 3
+    assert heap.result() == ["b", "d", "c"]
+
+
+def test_posix_scanner_streaming_top_n_matches_traversal() -> None:
+    from dux.models.enums import NodeKind
+    from dux.services.tree import top_nodes
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        sizes = {"a.bin": 5000, "b.bin": 300, "sub/c.bin": 9000, "sub/d.bin": 100}
+        for rel, size in sizes.items():
+            with open(os.path.join(tmpdir, rel), "wb") as f:
+                f.write(b"x" * size)
+
+        result = _posix_scanner(workers=1).scan(tmpdir, ScanOptions(top_n=2))
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.top_files is not None
+        assert snapshot.top_dirs is not None
+        assert [n.name for n in snapshot.top_files] == ["c.bin", "a.bin"]
+        assert snapshot.top_files == top_nodes(snapshot.root, 2, NodeKind.FILE)
+        assert snapshot.top_dirs == top_nodes(snapshot.root, 2, NodeKind.DIRECTORY)
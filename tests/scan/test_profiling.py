@@ -0,0 +1,87 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from result import Ok
+
+from dux._walker import scan_dir_nodes
+from dux.models.scan import ScanOptions
+from dux.scan import PythonScanner
+from dux.scan.native_scanner import NativeScanner
+from dux.ui.views import overview_rows
+from tests.fs_mock import MemoryFileSystem
+
+_PROFILE_KEYS = {
+    "wall_s",
+    "entries_per_s",
+    "finalize_s",
+    "walker_io_s",
+    "walker_gil_wait_s",
+    "walker_build_s",
+    "walker_calls",
+    "queue_steals",
+    "queue_parks",
+    "queue_park_s",
+}
+
+
+def _small_fs() -> MemoryFileSystem:
+    return (
+        MemoryFileSystem()
+        .add_dir("/root")
+        .add_file("/root/a.bin", size=10)
+        .add_file("/root/sub/b.bin", size=20)
+    )
+
+
+def test_profile_off_by_default() -> None:
+    result = PythonScanner(workers=1, fs=_small_fs()).scan("/root", ScanOptions())
+
+    assert isinstance(result, Ok)
+    assert result.unwrap().stats.profile is None
+
+
+def test_profile_dict_shape_python_scanner() -> None:
+    result = PythonScanner(workers=1, fs=_small_fs()).scan("/root", ScanOptions(profile=True))
+
+    assert isinstance(result, Ok)
+    profile = result.unwrap().stats.profile
+    assert profile is not None
+    assert set(profile) == _PROFILE_KEYS
+    assert profile["wall_s"] > 0
+    assert profile["entries_per_s"] > 0
+    # The Python scanner never enters the instrumented C walkers.
+    assert profile["walker_calls"] == 0
+
+
+def test_profile_counts_native_walker_calls(tmp_path: Path) -> None:
+    (tmp_path / "sub").mkdir()
+    (tmp_path / "sub" / "f.bin").write_bytes(b"x" * 100)
+    (tmp_path / "g.bin").write_bytes(b"y" * 50)
+
+    result = NativeScanner(scan_dir_nodes, workers=1).scan(str(tmp_path), ScanOptions(profile=True))
+
+    assert isinstance(result, Ok)
+    profile = result.unwrap().stats.profile
+    assert profile is not None
+    assert profile["walker_calls"] == 2  # root + sub
+    assert profile["walker_io_s"] >= 0
+    assert profile["walker_build_s"] > 0
+
+
+def test_overview_renders_profile_pane() -> None:
+    result = PythonScanner(workers=1, fs=_small_fs()).scan("/root", ScanOptions(profile=True))
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+
+    rows = overview_rows(snapshot.root, snapshot.stats, {}, overview_top=3, root_prefix="/root/")
+    names = [r.name for r in rows]
+    assert any("Scan profile" in n for n in names)
+    assert any(n.startswith("Walker I/O:") for n in names)
+
+    # Without profiling the pane is absent.
+    plain = PythonScanner(workers=1, fs=_small_fs()).scan("/root", ScanOptions())
+    assert isinstance(plain, Ok)
+    plain_snapshot = plain.unwrap()
+    rows = overview_rows(plain_snapshot.root, plain_snapshot.stats, {}, overview_top=3, root_prefix="/root/")
+    assert not any("Scan profile" in r.name for r in rows)
@@ -0,0 +1,92 @@
+from __future__ import annotations
+
+from result import Ok
+
+from dux.models.scan import ScanNode, ScanOptions
+from dux.scan import PythonScanner
+from tests.fs_mock import MemoryFileSystem
+
+
+def _uniform_fs(n_dirs: int, file_size: int) -> MemoryFileSystem:
+    fs = MemoryFileSystem().add_dir("/root")
+    for i in range(n_dirs):
+        fs.add_file(f"/root/d{i:02d}/data.bin", size=file_size)
+    return fs
+
+
+def _scan(fs: MemoryFileSystem, options: ScanOptions) -> tuple[ScanNode, object]:
+    result = PythonScanner(workers=1, fs=fs).scan("/root", options)
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    return snapshot.root, snapshot
+
+
+def test_sampling_extrapolates_uniform_tree_exactly() -> None:
+    root, snapshot = _scan(
+        _uniform_fs(10, file_size=100),
+        ScanOptions(sample_depth=0, sample_fraction=0.3),
+    )
+
+    sampled = [c for c in root.children if not c.estimated]
+    holes = [c for c in root.children if c.estimated]
+    assert len(sampled) == 3  # ceil(0.3 * 10)
+    assert len(holes) == 7
+    # Identical subtrees: extrapolation lands on the exact total with a
+    # zero-width interval.
+    assert root.size_bytes == 1000
+    assert all(c.size_bytes == 100 for c in root.children)
+    assert snapshot.size_margin == 0
+    assert root.estimated  # the root total itself is an estimate
+
+
+def test_sampling_margin_reflects_sample_spread() -> None:
+    fs = MemoryFileSystem().add_dir("/root")
+    for i in range(10):
+        fs.add_file(f"/root/d{i}/data.bin", size=100 * (i + 1))
+
+    root, snapshot = _scan(fs, ScanOptions(sample_depth=0, sample_fraction=0.5))
+
+    # The true total is 5500; with 5 of 10 subtrees measured the estimate
+    # should be in the right ballpark and carry a nonzero interval.
+    assert snapshot.size_margin is not None and snapshot.size_margin > 0
+    assert 2000 < root.size_bytes < 10000
+    holes = [c for c in root.children if c.estimated]
+    assert len(holes) == 5
+    assert all(c.unexpanded for c in holes)
+
+
+def test_sampling_is_deterministic() -> None:
+    options = ScanOptions(sample_depth=0, sample_fraction=0.3)
+    first, _ = _scan(_uniform_fs(10, file_size=100), options)
+    second, _ = _scan(_uniform_fs(10, file_size=100), options)
+
+    # The RNG is seeded with the directory path: the same tree always
+    # samples the same subset.
+    picked = lambda root: sorted(c.name for c in root.children if not c.estimated)  # noqa: E731
+    assert picked(first) == picked(second)
+
+
+def test_full_depth_above_sample_threshold() -> None:
+    fs = MemoryFileSystem().add_dir("/root")
+    for i in range(4):
+        for j in range(6):
+            fs.add_file(f"/root/top{i}/sub{j}/data.bin", size=50)
+
+    root, _ = _scan(fs, ScanOptions(sample_depth=1, sample_fraction=0.5))
+
+    # Depth 0 (the root's children) is enumerated exhaustively; sampling
+    # only kicks in one level down.
+    assert len(root.children) == 4
+    assert all(not c.estimated or c.children for c in root.children)
+    for top in root.children:
+        holes = [c for c in top.children if c.estimated and not c.children]
+        assert len(holes) == 3  # 6 subdirs, half sampled
+        assert top.size_bytes == 300  # uniform subtrees extrapolate exactly
+
+
+def test_no_sampling_without_sample_depth() -> None:
+    root, snapshot = _scan(_uniform_fs(10, file_size=100), ScanOptions())
+
+    assert snapshot.size_margin is None
+    assert not any(c.estimated for c in root.children)
+    assert root.size_bytes == 1000
@@ -0,0 +1,396 @@
+from __future__ import annotations
+
+import os
+import struct
+import tempfile
+
+import pytest
+
+from dux.models.enums import NodeKind
+
+
+def _scan(path: str, max_depth: int = -1):
+    from dux._scan_tree import ScanTree
+
+    return ScanTree.scan(path, NodeKind.DIRECTORY, NodeKind.FILE, max_depth)
+
+
+def test_scan_tree_counts_and_root() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        tree = _scan(tmpdir)
+
+        assert tree.file_count == 2
+        assert tree.dir_count == 2  # root + sub
+        assert tree.node_count == 4
+        assert tree.error_count == 0
+        assert tree.root_path == tmpdir
+        root = tree.root
+        assert root.path == tmpdir
+        assert root.kind is NodeKind.DIRECTORY
+        assert root.is_dir
+        assert root.parent is None
+
+
+def test_scan_tree_children_and_paths() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        tree = _scan(tmpdir)
+        children = {c.name: c for c in tree.root.children}
+
+        assert set(children) == {"sub", "a.txt"}
+        assert children["a.txt"].size_bytes == 100
+        assert children["a.txt"].kind is NodeKind.FILE
+        assert children["a.txt"].path == os.path.join(tmpdir, "a.txt")
+
+        sub = children["sub"]
+        (b_txt,) = sub.children
+        assert b_txt.name == "b.txt"
+        assert b_txt.size_bytes == 200
+        assert b_txt.path == os.path.join(tmpdir, "sub", "b.txt")
+        assert b_txt.parent == sub
+
+
+def test_scan_tree_max_depth_boundary_dirs_empty() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "lvl1", "lvl2"))
+        with open(os.path.join(tmpdir, "lvl1", "lvl2", "deep.txt"), "wb") as f:
+            f.write(b"z" * 50)
+
+        tree = _scan(tmpdir, max_depth=0)
+
+        lvl1 = next(c for c in tree.root.children if c.name == "lvl1")
+        assert lvl1.children == []
+        assert tree.file_count == 0
+
+
+def test_scan_tree_handles_share_arrays() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 10)
+
+        tree = _scan(tmpdir)
+        first = tree.root.children[0]
+        first.size_bytes = 999
+        first.disk_usage = 1024
+
+        # A fresh handle for the same node reads the same array slots.
+        again = tree.root.children[0]
+        assert again.size_bytes == 999
+        assert again.disk_usage == 1024
+
+
+def test_scan_tree_duck_types_for_tree_services() -> None:
+    from dux.services.tree import iter_nodes
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        tree = _scan(tmpdir)
+        names = {node.name for node in iter_nodes(tree.root)}
+
+        assert names == {os.path.basename(tmpdir), "b.txt", "sub"}
+
+
+def test_scan_tree_finalize_aggregates_and_sorts() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "big"))
+        os.makedirs(os.path.join(tmpdir, "small"))
+        with open(os.path.join(tmpdir, "big", "a.bin"), "wb") as f:
+            f.write(b"x" * 8192)
+        with open(os.path.join(tmpdir, "small", "b.bin"), "wb") as f:
+            f.write(b"y" * 100)
+
+        tree = _scan(tmpdir)
+        tree.finalize()
+
+        root = tree.root
+        assert root.size_bytes == 8192 + 100
+        assert root.disk_usage > 0
+        # Children sorted by disk_usage descending.
+        kids = root.children
+        assert [c.name for c in kids] == ["big", "small"]
+        big = kids[0]
+        assert big.size_bytes == 8192
+
+
+def test_scan_tree_finalize_idempotent() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 300)
+
+        tree = _scan(tmpdir)
+        tree.finalize()
+        tree.finalize()
+
+        assert tree.root.size_bytes == 300
+
+
+def test_scan_tree_scanner_snapshot() -> None:
+    from result import Ok
+
+    from dux.models.scan import ScanOptions
+    from dux.scan.scan_tree_scanner import ScanTreeScanner
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        result = ScanTreeScanner().scan(tmpdir, ScanOptions())
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.stats.files == 1
+        assert snapshot.stats.directories == 2
+        assert snapshot.root.path == tmpdir
+        assert snapshot.root.size_bytes == 200
+
+
+def test_scan_tree_missing_root_raises() -> None:
+    from dux._scan_tree import ScanTree
+
+    with pytest.raises(OSError):
+        ScanTree.scan("/nonexistent/dux-test-path", NodeKind.DIRECTORY, NodeKind.FILE)
+
+
+def test_scan_tree_node_not_constructible() -> None:
+    from dux._scan_tree import ScanTreeNode
+
+    with pytest.raises(TypeError):
+        ScanTreeNode()
+
+
+def test_scan_tree_save_load_roundtrip() -> None:
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        tree = _scan(tmpdir)
+        tree.finalize()
+        snap_path = os.path.join(tmpdir, "scan.duxsnap")
+        tree.save(snap_path)
+
+        loaded = ScanTree.load(snap_path, NodeKind.DIRECTORY, NodeKind.FILE)
+
+        assert loaded.node_count == tree.node_count
+        assert loaded.file_count == 2
+        assert loaded.dir_count == 2
+        assert loaded.root_path == tmpdir
+        assert loaded.root.size_bytes == 300
+        children = {c.name: c for c in loaded.root.children}
+        assert set(children) == {"sub", "a.txt"}
+        assert children["a.txt"].size_bytes == 100
+        assert children["a.txt"].path == os.path.join(tmpdir, "a.txt")
+
+
+def test_scan_tree_loaded_mapping_is_copy_on_write() -> None:
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+
+        tree = _scan(tmpdir)
+        tree.finalize()
+        snap_path = os.path.join(tmpdir, "scan.duxsnap")
+        tree.save(snap_path)
+
+        loaded = ScanTree.load(snap_path, NodeKind.DIRECTORY, NodeKind.FILE)
+        loaded.root.children[0].size_bytes = 12345
+        loaded.finalize()
+        assert loaded.root.size_bytes == 12345
+
+        # Writes stayed in memory: a fresh load sees the original data.
+        fresh = ScanTree.load(snap_path, NodeKind.DIRECTORY, NodeKind.FILE)
+        assert fresh.root.size_bytes == 100
+
+
+def test_scan_tree_load_rejects_garbage() -> None:
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        bad = os.path.join(tmpdir, "bad.duxsnap")
+        with open(bad, "wb") as f:
+            f.write(b"not a snapshot" * 10)
+        with pytest.raises(ValueError):
+            ScanTree.load(bad, NodeKind.DIRECTORY, NodeKind.FILE)
+        with pytest.raises(OSError):
+            ScanTree.load(os.path.join(tmpdir, "missing"), NodeKind.DIRECTORY, NodeKind.FILE)
+
+
+def test_scan_tree_load_rejects_corrupt_arrays() -> None:
+    # A snapshot whose length is self-consistent but whose node arrays
+    # hold wild values must raise, not hand out crashing indices.
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        tree = _scan(tmpdir)
+        snap_path = os.path.join(tmpdir, "scan.duxsnap")
+        tree.save(snap_path)
+
+        with open(snap_path, "rb") as f:
+            data = f.read()
+        _, count, names_used, _, _, _, rlen, _ = struct.unpack_from("<8sqqqqqqq", data, 0)
+        arrays = 64 + ((rlen + 7) & ~7)  # header + padded root path
+
+        corruptions = [
+            (arrays + count * 8 * 2, 1 << 40, "<q"),  # first_child[0] out of range
+            (arrays + count * 8 + 8, -5, "<q"),  # parent[1] below -1
+            (arrays, names_used + 100, "<q"),  # name_off[0] past the pool
+            (arrays + count * 8 * 7, 7, "<B"),  # kind[0] unknown code
+        ]
+        bad = os.path.join(tmpdir, "bad.duxsnap")
+        for offset, value, fmt in corruptions:
+            mutated = bytearray(data)
+            struct.pack_into(fmt, mutated, offset, value)
+            with open(bad, "wb") as f:
+                f.write(mutated)
+            with pytest.raises(ValueError):
+                ScanTree.load(bad, NodeKind.DIRECTORY, NodeKind.FILE)
+
+        # The pristine file still loads.
+        assert ScanTree.load(snap_path, NodeKind.DIRECTORY, NodeKind.FILE).file_count == 1
+
+
+def test_scan_tree_rescan_grafts_unchanged_dirs() -> None:
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "stale"))
+        os.makedirs(os.path.join(tmpdir, "fresh"))
+        with open(os.path.join(tmpdir, "stale", "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "fresh", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        prior = _scan(tmpdir)
+
+        # In-place rewrite: changes the file's mtime but not stale/'s, so
+        # the incremental scan must graft the prior (stale) subtree.
+        with open(os.path.join(tmpdir, "stale", "a.txt"), "wb") as f:
+            f.write(b"x" * 5000)
+        # New entry: changes fresh/'s mtime, so it must be rescanned.
+        with open(os.path.join(tmpdir, "fresh", "c.txt"), "wb") as f:
+            f.write(b"z" * 300)
+
+        tree = ScanTree.scan(
+            tmpdir, NodeKind.DIRECTORY, NodeKind.FILE, prior=prior
+        )
+        tree.finalize()
+
+        children = {c.name: c for c in tree.root.children}
+        assert children["stale"].size_bytes == 100  # grafted, not rewalked
+        assert children["fresh"].size_bytes == 500
+        assert tree.file_count == 3
+        assert tree.dir_count == 3
+
+
+def test_scan_tree_rescan_rejects_other_root() -> None:
+    from dux._scan_tree import ScanTree
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        prior = _scan(tmpdir)
+        with tempfile.TemporaryDirectory() as other:
+            with pytest.raises(ValueError):
+                ScanTree.scan(other, NodeKind.DIRECTORY, NodeKind.FILE, prior=prior)
+
+
+def test_incremental_rescan_roundtrip() -> None:
+    from dux.models.scan import ScanOptions
+    from dux.scan.scan_tree_scanner import ScanTreeScanner
+    from dux.services.snapshot_io import incremental_rescan, load_snapshot, save_snapshot
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        snapshot = ScanTreeScanner().scan(tmpdir, ScanOptions()).unwrap()
+        snap_path = os.path.join(tempfile.gettempdir(), f"dux-{os.getpid()}.duxsnap")
+        try:
+            save_snapshot(snapshot, snap_path)
+
+            with open(os.path.join(tmpdir, "sub", "c.txt"), "wb") as f:
+                f.write(b"z" * 300)
+
+            rescanned = incremental_rescan(load_snapshot(snap_path))
+            assert rescanned.stats.files == 2
+            assert rescanned.root.size_bytes == 500
+        finally:
+            os.unlink(snap_path)
+
+
+def test_snapshot_io_roundtrip() -> None:
+    from dux.models.scan import ScanOptions
+    from dux.scan.scan_tree_scanner import ScanTreeScanner
+    from dux.services.snapshot_io import load_snapshot, save_snapshot
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+
+        snapshot = ScanTreeScanner().scan(tmpdir, ScanOptions()).unwrap()
+        snap_path = os.path.join(tmpdir, "scan.duxsnap")
+        save_snapshot(snapshot, snap_path)
+
+        loaded = load_snapshot(snap_path)
+        assert loaded.stats == snapshot.stats
+        assert loaded.root.path == tmpdir
+        assert loaded.root.size_bytes == snapshot.root.size_bytes
+
+
+def test_snapshot_io_rejects_scannode_snapshot() -> None:
+    from dux.models.scan import ScanNode, ScanSnapshot, ScanStats
+    from dux.services.snapshot_io import save_snapshot
+
+    snapshot = ScanSnapshot(
+        root=ScanNode.directory("/tmp"),
+        stats=ScanStats(files=0, directories=1, access_errors=0),
+    )
+    with pytest.raises(TypeError):
+        save_snapshot(snapshot, "/tmp/never-written.duxsnap")
+
+
+def test_by_extension_matches_python_aggregation() -> None:
+    from dux.services.tree import extension_totals
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        for rel, size in {
+            "a.TXT": 100,
+            "sub/b.txt": 200,
+            "sub/noext": 50,
+            "archive.tar.gz": 30,
+        }.items():
+            with open(os.path.join(tmpdir, rel), "wb") as f:
+                f.write(b"x" * size)
+
+        tree = _scan(tmpdir)
+        totals = tree.by_extension()
+
+        counts = {ext: agg[0] for ext, agg in totals.items()}
+        assert counts == {"txt": 2, "": 1, "gz": 1}
+        assert totals["txt"][1] == 300
+        # The handle duck-types ScanNode, so extension_totals dispatches
+        # here too and must agree with the native sweep.
+        assert extension_totals(tree.root) == totals
@@ -130,3 +130,114 @@ def test_cancellation_respected() -> None:
     error = result.unwrap_err()
     assert error.code is ScanErrorCode.CANCELLED
     assert "cancel" in error.message.lower()
+
+
+def test_python_scanner_dedup_hardlinks() -> None:
+    # Hardlinks need a real filesystem; the mock has no inode identity.
+    import os
+    import tempfile
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        original = os.path.join(tmpdir, "original.bin")
+        with open(original, "wb") as f:
+            f.write(b"x" * 4096)
+        os.link(original, os.path.join(tmpdir, "link.bin"))
+
+        plain = PythonScanner(workers=1).scan(tmpdir, ScanOptions())
+        deduped = PythonScanner(workers=1).scan(tmpdir, ScanOptions(dedup_hardlinks=True))
+
+        assert isinstance(plain, Ok)
+        assert isinstance(deduped, Ok)
+        assert plain.unwrap().root.size_bytes == 2 * 4096
+        assert deduped.unwrap().root.size_bytes == 4096
+        assert deduped.unwrap().stats.files == 2
+
+
+def test_one_filesystem_keeps_mount_points_as_leaves() -> None:
+    fs = (
+        MemoryFileSystem()
+        .add_dir("/root")
+        .add_file("/root/local.bin", size=100)
+        .add_dir("/root/mnt", dev=2)
+        .add_file("/root/mnt/remote.bin", size=999)
+    )
+
+    result = PythonScanner(workers=1, fs=fs).scan("/root", ScanOptions(one_filesystem=True))
+
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    mnt = next(c for c in snapshot.root.children if c.name == "mnt")
+    # The mount point itself stays in the tree, but nothing below it.
+    assert mnt.is_dir
+    assert mnt.children == []
+    assert snapshot.root.size_bytes == 100
+
+
+def test_one_filesystem_off_descends_into_mounts() -> None:
+    fs = (
+        MemoryFileSystem()
+        .add_dir("/root")
+        .add_dir("/root/mnt", dev=2)
+        .add_file("/root/mnt/remote.bin", size=999)
+    )
+
+    result = PythonScanner(workers=1, fs=fs).scan("/root", ScanOptions())
+
+    assert isinstance(result, Ok)
+    assert result.unwrap().root.size_bytes == 999
+
+
+def test_prune_dirs_flags_and_skips_subtrees() -> None:
+    fs = (
+        MemoryFileSystem()
+        .add_dir("/root")
+        .add_file("/root/keep.bin", size=100)
+        .add_file("/root/node_modules/dep/huge.js", size=5000)
+        .add_file("/root/src/main.py", size=50)
+    )
+
+    result = PythonScanner(workers=1, fs=fs).scan(
+        "/root", ScanOptions(prune_dirs=frozenset({"node_modules"}))
+    )
+
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    nm = next(c for c in snapshot.root.children if c.name == "node_modules")
+    assert nm.unexpanded
+    assert nm.children == []
+    src = next(c for c in snapshot.root.children if c.name == "src")
+    assert not src.unexpanded
+    assert len(src.children) == 1
+    # Pruned subtree contributes nothing.
+    assert snapshot.root.size_bytes == 150
+
+
+def test_streaming_top_n_attached_to_snapshot() -> None:
+    fs = (
+        MemoryFileSystem()
+        .add_dir("/root")
+        .add_file("/root/big.bin", size=5000)
+        .add_file("/root/small.bin", size=10)
+        .add_file("/root/logs/huge.log", size=9000)
+        .add_file("/root/src/main.py", size=50)
+    )
+
+    result = PythonScanner(workers=1, fs=fs).scan("/root", ScanOptions(top_n=2))
+
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    assert snapshot.top_files is not None
+    assert snapshot.top_dirs is not None
+    assert [n.name for n in snapshot.top_files] == ["huge.log", "big.bin"]
+    # The root itself is excluded, like tree.top_nodes.
+    assert [n.name for n in snapshot.top_dirs] == ["logs", "src"]
+
+
+def test_top_n_off_leaves_snapshot_lists_unset() -> None:
+    fs = MemoryFileSystem().add_dir("/root").add_file("/root/a.bin", size=10)
+
+    result = PythonScanner(workers=1, fs=fs).scan("/root", ScanOptions())
+
+    assert isinstance(result, Ok)
+    assert result.unwrap().top_files is None
+    assert result.unwrap().top_dirs is None
@@ -0,0 +1,101 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from result import Err, Ok
+
+from dux._walker import scan_dir_nodes
+from dux.models.scan import ScanErrorCode, ScanNode, ScanOptions
+from dux.scan import create_scanner
+from dux.scan.python_scanner import PythonScanner
+from dux.scan.sharded_scanner import ShardedScanner
+
+
+def _build_tree(root: Path) -> None:
+    # Wide enough that the warm-up frontier fills and the parallel phase
+    # actually distributes subtrees.
+    for i in range(12):
+        sub = root / f"top{i:02d}"
+        (sub / "nested").mkdir(parents=True)
+        (sub / "a.bin").write_bytes(b"x" * 100)
+        (sub / "nested" / "b.bin").write_bytes(b"y" * 50)
+    (root / "loose.bin").write_bytes(b"z" * 25)
+
+
+def _tree_shape(node: ScanNode) -> list[tuple[str, int, int]]:
+    out = [(node.name, node.size_bytes, len(node.children))]
+    for child in sorted(node.children, key=lambda c: c.name):
+        out.extend(_tree_shape(child))
+    return out
+
+
+def test_matches_python_scanner_output(tmp_path: Path) -> None:
+    _build_tree(tmp_path)
+
+    sharded = ShardedScanner(scan_dir_nodes, workers=4).scan(str(tmp_path), ScanOptions())
+    reference = PythonScanner(workers=1).scan(str(tmp_path), ScanOptions())
+
+    assert isinstance(sharded, Ok)
+    assert isinstance(reference, Ok)
+    a, b = sharded.unwrap(), reference.unwrap()
+    assert a.stats.files == b.stats.files
+    assert a.stats.directories == b.stats.directories
+    assert a.root.size_bytes == b.root.size_bytes
+    assert _tree_shape(a.root)[1:] == _tree_shape(b.root)[1:]  # roots differ in name form only
+
+
+def test_respects_max_depth_and_prune(tmp_path: Path) -> None:
+    _build_tree(tmp_path)
+    (tmp_path / "top00" / "node_modules" / "pkg").mkdir(parents=True)
+    (tmp_path / "top00" / "node_modules" / "pkg" / "big.bin").write_bytes(b"x" * 1000)
+
+    options = ScanOptions(max_depth=2, prune_dirs=frozenset({"node_modules"}))
+    result = ShardedScanner(scan_dir_nodes, workers=2).scan(str(tmp_path), options)
+
+    assert isinstance(result, Ok)
+    root = result.unwrap().root
+    top = next(c for c in root.children if c.name == "top00")
+    pruned = next(c for c in top.children if c.name == "node_modules")
+    assert pruned.unexpanded
+    assert pruned.size_bytes == 0
+    assert root.size_bytes == 12 * 150 + 25
+
+
+def test_missing_path_returns_error(tmp_path: Path) -> None:
+    result = ShardedScanner(scan_dir_nodes, workers=2).scan(str(tmp_path / "gone"), ScanOptions())
+
+    assert isinstance(result, Err)
+    assert result.unwrap_err().code is ScanErrorCode.NOT_FOUND
+
+
+def test_cancellation(tmp_path: Path) -> None:
+    _build_tree(tmp_path)
+
+    result = ShardedScanner(scan_dir_nodes, workers=2).scan(
+        str(tmp_path), ScanOptions(), cancel_check=lambda: True
+    )
+
+    assert isinstance(result, Err)
+    assert result.unwrap_err().code is ScanErrorCode.CANCELLED
+
+
+def test_top_n_collection(tmp_path: Path) -> None:
+    _build_tree(tmp_path)
+    # Block-sized so the disk-usage ranking is unambiguous (the 100/50-byte
+    # files all occupy a single block and would tie).
+    (tmp_path / "top03" / "big1.bin").write_bytes(b"x" * 4096 * 8)
+    (tmp_path / "top07" / "nested" / "big2.bin").write_bytes(b"x" * 4096 * 4)
+    (tmp_path / "big3.bin").write_bytes(b"x" * 4096 * 2)
+
+    result = ShardedScanner(scan_dir_nodes, workers=4).scan(str(tmp_path), ScanOptions(top_n=3))
+
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    assert snapshot.top_files is not None
+    assert [f.name for f in snapshot.top_files] == ["big1.bin", "big2.bin", "big3.bin"]
+
+
+def test_create_scanner_knows_nogil() -> None:
+    scanner = create_scanner("nogil", workers=2)
+    assert isinstance(scanner, ShardedScanner)
+    assert scanner.label == "nogil/subtree-sharded"
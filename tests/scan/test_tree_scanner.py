@@ -0,0 +1,98 @@
+from __future__ import annotations
+
+import os
+import tempfile
+
+from result import Ok
+
+from dux.models.scan import ScanOptions
+from dux.scan.native_scanner import NativeTreeScanner
+
+
+def _make_deep_tree(tmpdir: str, levels: int) -> None:
+    """One file per level: lvl0/f0.txt, lvl0/lvl1/f1.txt, ..."""
+    current = tmpdir
+    for lvl in range(levels):
+        current = os.path.join(current, f"lvl{lvl}")
+        os.makedirs(current)
+        with open(os.path.join(current, f"f{lvl}.txt"), "wb") as f:
+            f.write(b"x" * 10)
+
+
+def test_tree_scanner_basic() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "sub"))
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "sub", "b.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        result = NativeTreeScanner().scan(tmpdir, ScanOptions())
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.stats.files == 2
+        assert snapshot.stats.directories >= 2
+        assert snapshot.root.size_bytes == 300
+        assert snapshot.root.path == tmpdir
+
+
+def test_tree_scanner_deeper_than_chunk() -> None:
+    # 10 levels forces several frontier hand-offs (chunk is 4 levels).
+    with tempfile.TemporaryDirectory() as tmpdir:
+        _make_deep_tree(tmpdir, levels=10)
+
+        result = NativeTreeScanner().scan(tmpdir, ScanOptions())
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        assert snapshot.stats.files == 10
+        assert snapshot.root.size_bytes == 100
+
+        node = snapshot.root
+        for lvl in range(10):
+            node = next(c for c in node.children if c.name == f"lvl{lvl}")
+        assert [c.name for c in node.children] == ["f9.txt"]
+
+
+def test_tree_scanner_max_depth_inside_chunk() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        _make_deep_tree(tmpdir, levels=6)
+
+        result = NativeTreeScanner().scan(tmpdir, ScanOptions(max_depth=1))
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        lvl0 = next(c for c in snapshot.root.children if c.name == "lvl0")
+        lvl1 = next(c for c in lvl0.children if c.name == "lvl1")
+        assert lvl1.children == []
+
+
+def test_tree_scanner_max_depth_beyond_chunk() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        _make_deep_tree(tmpdir, levels=8)
+
+        # max_depth=5 crosses one chunk boundary (4 levels per chunk).
+        result = NativeTreeScanner().scan(tmpdir, ScanOptions(max_depth=5))
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        # Same contract as the per-directory scanners: nodes exist down to
+        # max_depth + 1 levels, and directories at the boundary stay empty.
+        node = snapshot.root
+        for lvl in range(6):
+            node = next(c for c in node.children if c.name == f"lvl{lvl}")
+        assert node.children == []
+        assert snapshot.stats.files == 5
+
+
+def test_tree_scanner_max_depth_zero() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        _make_deep_tree(tmpdir, levels=2)
+
+        result = NativeTreeScanner().scan(tmpdir, ScanOptions(max_depth=0))
+
+        assert isinstance(result, Ok)
+        snapshot = result.unwrap()
+        lvl0 = next(c for c in snapshot.root.children if c.name == "lvl0")
+        assert lvl0.children == []
@@ -185,3 +185,71 @@ def test_repeated_pattern_in_text() -> None:
     result = ac.iter("aaa")
     # "aa" at positions 0-1 (end=1) and 1-2 (end=2)
     assert result == [(1, 1), (2, 1)]
+
+
+def test_bytes_outside_pattern_alphabet_reset_matching() -> None:
+    # The compacted goto table maps every byte not present in any pattern
+    # to a shared "restart" class; matches on either side must still land.
+    ac = AhoCorasick()
+    ac.add_word("cache", 1)
+    ac.make_automaton()
+    result = ac.iter("Zcache\x00cacheZ")
+    assert [val for _, val in result] == [1, 1]
+
+
+def test_partial_match_interrupted_by_foreign_byte() -> None:
+    ac = AhoCorasick()
+    ac.add_word("abc", 1)
+    ac.make_automaton()
+    # 'X' is outside the pattern alphabet: it must reset to root, so the
+    # following complete occurrence is still found.
+    assert ac.iter("abXabc") == [(5, 1)]
+
+
+def test_iter_many_returns_only_matching_paths() -> None:
+    ac = AhoCorasick()
+    ac.add_word("/tmp/", "t")
+    ac.add_word(".log", "l")
+    ac.make_automaton()
+    result = ac.iter_many(["/a/b.txt", "/a/tmp/x.log", "/c/d", "/e.log"])
+    # Non-matching paths (indices 0 and 2) are omitted entirely.
+    assert result == [
+        (1, [(6, "t"), (11, "l")]),
+        (3, [(5, "l")]),
+    ]
+
+
+def test_iter_many_agrees_with_iter() -> None:
+    ac = AhoCorasick()
+    ac.add_word("he", 1)
+    ac.add_word("she", 2)
+    ac.add_word("hers", 3)
+    ac.make_automaton()
+    paths = ["shers", "nothing", "he", "", "xxhexx"]
+    batched = dict(ac.iter_many(paths))
+    for i, path in enumerate(paths):
+        assert batched.get(i, []) == ac.iter(path)
+
+
+def test_iter_many_empty_list() -> None:
+    ac = AhoCorasick()
+    ac.add_word("a", 1)
+    ac.make_automaton()
+    assert ac.iter_many([]) == []
+
+
+def test_iter_many_before_make_automaton_raises() -> None:
+    ac = AhoCorasick()
+    ac.add_word("x", 1)
+    with pytest.raises(RuntimeError, match="call make_automaton"):
+        ac.iter_many(["x"])
+
+
+def test_iter_many_rejects_non_list_and_non_str_items() -> None:
+    ac = AhoCorasick()
+    ac.add_word("x", 1)
+    ac.make_automaton()
+    with pytest.raises(TypeError):
+        ac.iter_many(("x",))  # type: ignore[arg-type]
+    with pytest.raises(TypeError):
+        ac.iter_many(["ok", 42])  # type: ignore[list-item]
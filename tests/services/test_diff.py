@@ -0,0 +1,98 @@
+from __future__ import annotations
+
+import os
+import tempfile
+
+import pytest
+
+from dux.models.enums import DiffStatus, NodeKind
+
+
+def _scan(path: str):
+    from dux._scan_tree import ScanTree
+
+    return ScanTree.scan(path, NodeKind.DIRECTORY, NodeKind.FILE)
+
+
+def test_tree_diff_reports_adds_removes_and_changes() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        os.makedirs(os.path.join(tmpdir, "keep"))
+        os.makedirs(os.path.join(tmpdir, "gone"))
+        with open(os.path.join(tmpdir, "keep", "grow.txt"), "wb") as f:
+            f.write(b"x" * 100)
+        with open(os.path.join(tmpdir, "gone", "old.txt"), "wb") as f:
+            f.write(b"y" * 200)
+
+        old = _scan(tmpdir)
+
+        with open(os.path.join(tmpdir, "keep", "grow.txt"), "wb") as f:
+            f.write(b"x" * 5000)
+        with open(os.path.join(tmpdir, "keep", "new.txt"), "wb") as f:
+            f.write(b"z" * 300)
+        os.unlink(os.path.join(tmpdir, "gone", "old.txt"))
+        os.rmdir(os.path.join(tmpdir, "gone"))
+
+        new = _scan(tmpdir)
+        records = new.diff(old)
+        by_path = {path: (status, dsize, added, removed) for path, _, status, dsize, _, added, removed in records}
+
+        from dux import _scan_tree as st
+
+        assert by_path[os.path.join(tmpdir, "keep", "grow.txt")][0] == st.DIFF_CHANGED
+        assert by_path[os.path.join(tmpdir, "keep", "grow.txt")][1] == 4900
+        assert by_path[os.path.join(tmpdir, "keep", "new.txt")][0] == st.DIFF_ADDED
+        assert by_path[os.path.join(tmpdir, "gone")] == (st.DIFF_REMOVED, -200, 0, 2)
+        # Per-subtree attribution: keep/ and the root both carry the net delta.
+        assert by_path[os.path.join(tmpdir, "keep")] == (st.DIFF_CHANGED, 4900 + 300, 1, 0)
+        assert by_path[tmpdir] == (st.DIFF_CHANGED, 4900 + 300 - 200, 1, 2)
+
+
+def test_tree_diff_identical_trees_is_empty() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with open(os.path.join(tmpdir, "a.txt"), "wb") as f:
+            f.write(b"x" * 100)
+
+        old = _scan(tmpdir)
+        new = _scan(tmpdir)
+        assert new.diff(old) == []
+
+
+def test_tree_diff_rejects_different_roots() -> None:
+    with tempfile.TemporaryDirectory() as a, tempfile.TemporaryDirectory() as b:
+        with pytest.raises(ValueError):
+            _scan(a).diff(_scan(b))
+
+
+def test_diff_snapshots_sorts_biggest_movers_first() -> None:
+    from dux.models.scan import ScanOptions
+    from dux.scan.scan_tree_scanner import ScanTreeScanner
+    from dux.services.diff import diff_snapshots
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        old = ScanTreeScanner().scan(tmpdir, ScanOptions()).unwrap()
+
+        with open(os.path.join(tmpdir, "small.txt"), "wb") as f:
+            f.write(b"x" * 10)
+        with open(os.path.join(tmpdir, "big.bin"), "wb") as f:
+            f.write(b"y" * 65536)
+
+        new = ScanTreeScanner().scan(tmpdir, ScanOptions()).unwrap()
+        entries = diff_snapshots(old, new)
+
+        assert entries[0].path == tmpdir  # root summary carries the full delta
+        assert entries[1].path == os.path.join(tmpdir, "big.bin")
+        assert entries[1].status is DiffStatus.ADDED
+        assert entries[1].delta_size == 65536
+        assert entries[-1].path == os.path.join(tmpdir, "small.txt")
+
+
+def test_diff_snapshots_rejects_scannode_snapshot() -> None:
+    from dux.models.scan import ScanNode, ScanSnapshot, ScanStats
+    from dux.services.diff import diff_snapshots
+
+    snap = ScanSnapshot(
+        root=ScanNode.directory("/tmp"),
+        stats=ScanStats(files=0, directories=1, access_errors=0),
+    )
+    with pytest.raises(TypeError):
+        diff_snapshots(snap, snap)
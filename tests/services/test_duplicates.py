@@ -0,0 +1,95 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from result import Ok
+
+from dux._hasher import SAMPLE_SPAN
+from dux.config.defaults import default_config
+from dux.models.enums import InsightCategory
+from dux.models.scan import ScanNode, ScanOptions
+from dux.scan.python_scanner import PythonScanner
+from dux.services.duplicates import DuplicateGroup, find_duplicates
+from dux.services.insights import generate_insights, merge_duplicate_insights
+
+
+def _scan(path: Path) -> ScanNode:
+    result = PythonScanner(workers=1).scan(str(path), ScanOptions())
+    assert isinstance(result, Ok)
+    return result.unwrap().root
+
+
+def test_finds_identical_files(tmp_path: Path) -> None:
+    # Bigger than SAMPLE_SPAN so both hashing passes run.
+    payload = bytes(range(256)) * 1024
+    (tmp_path / "a.bin").write_bytes(payload)
+    (tmp_path / "sub").mkdir()
+    (tmp_path / "sub" / "b.bin").write_bytes(payload)
+    (tmp_path / "other.bin").write_bytes(payload[::-1])
+
+    groups = find_duplicates(_scan(tmp_path), min_size=1024)
+
+    assert len(groups) == 1
+    group = groups[0]
+    assert group.size_bytes == len(payload)
+    assert [Path(p).name for p in group.paths] == ["a.bin", "b.bin"]
+    assert group.reclaimable == group.disk_usage
+
+
+def test_unique_sizes_need_no_hashing(tmp_path: Path) -> None:
+    (tmp_path / "a.bin").write_bytes(b"x" * 2048)
+    (tmp_path / "b.bin").write_bytes(b"x" * 4096)
+
+    assert find_duplicates(_scan(tmp_path), min_size=1024) == []
+
+
+def test_mid_file_difference_caught_by_full_pass(tmp_path: Path) -> None:
+    # Same size, identical within the sampled head/middle/tail blocks,
+    # differing only in a region the sample never reads — the full pass
+    # must separate them.
+    size = SAMPLE_SPAN * 2
+    base = bytearray(b"x" * size)
+    (tmp_path / "a.bin").write_bytes(bytes(base))
+    base[SAMPLE_SPAN // 2 + SAMPLE_SPAN // 8] = ord("y")
+    (tmp_path / "b.bin").write_bytes(bytes(base))
+
+    assert find_duplicates(_scan(tmp_path), min_size=1024) == []
+
+
+def test_min_size_threshold(tmp_path: Path) -> None:
+    (tmp_path / "a.txt").write_bytes(b"same" * 10)
+    (tmp_path / "b.txt").write_bytes(b"same" * 10)
+
+    assert find_duplicates(_scan(tmp_path), min_size=1024) == []
+    assert len(find_duplicates(_scan(tmp_path), min_size=1)) == 1
+
+
+def test_groups_sorted_by_reclaimable(tmp_path: Path) -> None:
+    small = b"s" * 8192
+    big = b"b" * 65536
+    for name in ("s1", "s2", "b1", "b2", "b3"):
+        data = small if name.startswith("s") else big
+        (tmp_path / name).write_bytes(data)
+
+    groups = find_duplicates(_scan(tmp_path), min_size=1024)
+
+    assert [len(g.paths) for g in groups] == [3, 2]
+    assert groups[0].reclaimable > groups[1].reclaimable
+
+
+def test_merge_duplicate_insights() -> None:
+    from tests.factories import make_dir
+
+    bundle = generate_insights(make_dir("/root", du=0, children=[]), default_config())
+    groups = [
+        DuplicateGroup(size_bytes=100, disk_usage=4096, paths=("/root/a", "/root/b")),
+    ]
+
+    merged = merge_duplicate_insights(bundle, groups, max_insights=50)
+
+    dupes = [i for i in merged.insights if i.category is InsightCategory.DUPLICATE]
+    assert [i.path for i in dupes] == ["/root/a", "/root/b"]
+    assert all(i.summary == "Duplicate x2" for i in dupes)
+    stats = merged.by_category[InsightCategory.DUPLICATE]
+    assert stats.count == 2
+    assert stats.disk_usage == 2 * 4096
@@ -15,6 +15,7 @@ from dux.services.patterns import (
     _expand_braces,
     compile_ruleset,
     match_all,
+    match_many,
 )
 
 
@@ -543,3 +544,62 @@ def test_case_insensitive_through_pipeline(default_ruleset: CompiledRuleSet) ->
     path = "/A/NODE_MODULES/foo"
     result = match_all(default_ruleset, path.lower(), "foo", is_dir=False)
     assert any(r.category == InsightCategory.BUILD_ARTIFACT for r in result)
+
+
+# ── match_many (batched) ────────────────────────────────────────────
+
+
+def test_match_many_agrees_with_match_all() -> None:
+    rs = compile_ruleset(
+        [
+            _rule("nm", "**/node_modules/**"),
+            _rule("log", "**/*.log", category=InsightCategory.CACHE, apply_to="file"),
+            _rule("exact", "**/thumbs.db", category=InsightCategory.CACHE),
+        ]
+    )
+    items = [
+        ("/x/node_modules/y", "y", True),
+        ("/a/b.log", "b.log", False),
+        ("/a/b.log", "b.log", True),  # LOG is file-only: no match
+        ("/c/thumbs.db", "thumbs.db", False),
+        ("/plain/file.txt", "file.txt", False),
+    ]
+    batched = match_many(rs, items)
+    assert len(batched) == len(items)
+    for (lpath, lbase, is_dir), rules in zip(items, batched, strict=True):
+        assert rules == match_all(rs, lpath, lbase, is_dir)
+
+
+def test_match_many_empty_batch() -> None:
+    rs = compile_ruleset([_rule("nm", "**/node_modules/**")])
+    assert match_many(rs, []) == []
+
+
+def test_prune_dir_basenames_from_defaults() -> None:
+    from dux.config.defaults import default_config
+    from dux.services.patterns import prune_dir_basenames
+
+    names = prune_dir_basenames(default_config().patterns)
+    assert "node_modules" in names
+    assert ".venv" in names
+    # tmp rules are not stop_recursion, so they never prune.
+    assert "tmp" not in names
+
+
+def test_prune_dir_basenames_shapes() -> None:
+    from dux.services.patterns import prune_dir_basenames
+
+    rules = [
+        PatternRule("exact", "**/Build", InsightCategory.TEMP, stop_recursion=True),
+        PatternRule("contains", "**/dist/**", InsightCategory.TEMP, stop_recursion=True),
+        PatternRule("braces", "**/{out,bin}/**", InsightCategory.TEMP, stop_recursion=True),
+        # Multi-segment CONTAINS needs descendant paths — never prunes.
+        PatternRule("nested", "**/a/b/**", InsightCategory.TEMP, stop_recursion=True),
+        # Files can't be descended into; glob shapes can't be reduced.
+        PatternRule("file", "**/core", InsightCategory.TEMP, ApplyTo.FILE, stop_recursion=True),
+        PatternRule("glob", "**/*.egg-info/**", InsightCategory.TEMP, stop_recursion=True),
+        # Not stop_recursion: labelled but never pruned.
+        PatternRule("plain", "**/logs/**", InsightCategory.TEMP),
+    ]
+
+    assert prune_dir_basenames(rules) == frozenset({"build", "dist", "out", "bin"})
@@ -0,0 +1,280 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from dux._ruleset import CompiledRuleSetNative
+from dux.config.schema import PatternRule
+from dux.models.enums import ApplyTo, InsightCategory
+from dux.services.patterns import compile_ruleset, compile_ruleset_native, match_all
+
+_APPLY_TO_STR: dict[str, ApplyTo] = {"file": ApplyTo.FILE, "dir": ApplyTo.DIR, "both": ApplyTo.BOTH}
+
+
+def _rule(
+    name: str,
+    pattern: str,
+    category: InsightCategory = InsightCategory.TEMP,
+    apply_to: str = "both",
+) -> PatternRule:
+    return PatternRule(name=name, pattern=pattern, category=category, apply_to=_APPLY_TO_STR[apply_to])
+
+
+_RULES = [
+    _rule("nm", "**/node_modules/**", InsightCategory.BUILD_ARTIFACT),
+    _rule("tmp", "**/tmp/**", InsightCategory.TEMP),
+    _rule("log", "**/*.log", InsightCategory.CACHE, apply_to="file"),
+    _rule("thumbs", "**/thumbs.db", InsightCategory.CACHE),
+    _rule("npm-dbg", "**/npm-debug*", InsightCategory.TEMP, apply_to="file"),
+    _rule("swap", "**/*.{swp,swo}", InsightCategory.TEMP, apply_to="file"),
+    _rule("glob", "build/*/out", InsightCategory.BUILD_ARTIFACT),
+]
+
+_PROBES = [
+    ("/x/node_modules/pkg", "pkg", True),
+    ("/x/node_modules/pkg", "pkg", False),
+    ("/a/tmp", "tmp", True),
+    ("/a/tmp/f.log", "f.log", False),
+    ("/c/thumbs.db", "thumbs.db", False),
+    ("/c/npm-debug.log", "npm-debug.log", False),
+    ("/c/x.swp", "x.swp", False),
+    ("build/debug/out", "out", False),
+    ("/plain/file.txt", "file.txt", False),
+    ("", "", False),
+]
+
+
+def test_native_match_agrees_with_python_match_all() -> None:
+    py = compile_ruleset(_RULES)
+    native = compile_ruleset_native(_RULES)
+    for lpath, lbase, is_dir in _PROBES:
+        assert native.match(lpath, lbase, is_dir) == match_all(py, lpath, lbase, is_dir), (
+            lpath,
+            is_dir,
+        )
+
+
+def test_native_match_many_agrees_with_match() -> None:
+    native = compile_ruleset_native(_RULES)
+    batched = native.match_many(list(_PROBES))
+    assert len(batched) == len(_PROBES)
+    for (lpath, lbase, is_dir), rules in zip(_PROBES, batched, strict=True):
+        assert rules == native.match(lpath, lbase, is_dir)
+
+
+def test_native_first_match_wins_per_category() -> None:
+    # Both rules are TEMP; the exact tier runs before the AC tier, so
+    # only the exact rule is returned.
+    exact = _rule("exact", "**/core", InsightCategory.TEMP)
+    contains = _rule("contains", "**/core/**", InsightCategory.TEMP)
+    native = compile_ruleset_native([exact, contains])
+    result = native.match("/a/core/b/core", "core", False)
+    assert result == [exact]
+
+
+def test_native_end_only_suffix_does_not_fire_mid_path() -> None:
+    native = compile_ruleset_native([_rule("log", "**/*.log", apply_to="file")])
+    assert native.match("/a/x.log/inner", "inner", False) == []
+    assert len(native.match("/a/x.log", "x.log", False)) == 1
+
+
+def test_native_kind_split() -> None:
+    native = compile_ruleset_native([_rule("log", "**/*.log", apply_to="file")])
+    assert native.match("/a/b.log", "b.log", True) == []
+    assert len(native.match("/a/b.log", "b.log", False)) == 1
+
+
+def test_native_additional_paths() -> None:
+    rule = _rule("cache", "/home/u/.cache", InsightCategory.CACHE)
+    native = compile_ruleset_native([], additional_paths=[("/home/u/.cache", rule)])
+    assert native.match("/home/u/.cache", ".cache", True) == [rule]
+    assert native.match("/home/u/.cache/pip/wheels", "wheels", False) == [rule]
+    assert native.match("/home/u/.cachefoo", ".cachefoo", True) == []
+
+
+def test_native_glob_dir_pattern_matches_dir_itself() -> None:
+    # "foo/bar/**" must match the directory "foo/bar" too, mirroring
+    # _match_pattern_slow's base-pattern retry.
+    native = compile_ruleset_native([_rule("g", "foo/*/baz/**")])
+    assert len(native.match("foo/x/baz", "baz", True)) == 1
+    assert len(native.match("foo/x/baz/deep", "deep", True)) == 1
+
+
+def test_native_match_before_build_raises() -> None:
+    rs = CompiledRuleSetNative()
+    with pytest.raises(RuntimeError, match="call build"):
+        rs.match("/a", "a", False)
+    with pytest.raises(RuntimeError, match="call build"):
+        rs.match_many([("/a", "a", False)])
+
+
+def test_native_add_after_build_raises() -> None:
+    rs = CompiledRuleSetNative()
+    rs.build()
+    with pytest.raises(RuntimeError, match="cannot add rules after build"):
+        rs.add_exact(0, "x", object(), 0)
+
+
+def test_native_rejects_bad_kind_and_category() -> None:
+    rs = CompiledRuleSetNative()
+    with pytest.raises(ValueError, match="kind"):
+        rs.add_exact(2, "x", object(), 0)
+    with pytest.raises(ValueError, match="category"):
+        rs.add_exact(0, "x", object(), 64)
+
+
+def test_native_match_many_empty_and_bad_items() -> None:
+    native = compile_ruleset_native([_rule("nm", "**/node_modules/**")])
+    assert native.match_many([]) == []
+    with pytest.raises(TypeError):
+        native.match_many([("only-two", "x")])  # type: ignore[list-item]
+
+
+# ── compiled glob programs ──────────────────────────────────────────
+# The GLOB tier compiles patterns once into C segment programs; these
+# pin the fnmatch semantics the compiler must reproduce.
+
+
+def _glob_hits(pattern: str, path: str, base: str, is_dir: bool = False) -> bool:
+    native = compile_ruleset_native([_rule("g", pattern)])
+    return len(native.match(path, base, is_dir)) == 1
+
+
+def test_glob_star_crosses_slashes() -> None:
+    assert _glob_hits("src/*/deep.txt", "src/a/b/deep.txt", "deep.txt")
+
+
+def test_glob_question_mark_single_byte() -> None:
+    assert _glob_hits("v?.txt", "v1.txt", "v1.txt")
+    assert not _glob_hits("v?.txt", "v12.txt", "v12.txt")
+
+
+def test_glob_char_class_and_range() -> None:
+    assert _glob_hits("rev[0-9].bin", "rev7.bin", "rev7.bin")
+    assert not _glob_hits("rev[0-9].bin", "revx.bin", "revx.bin")
+    assert _glob_hits("f.[co]", "f.c", "f.c")
+
+
+def test_glob_negated_class() -> None:
+    assert _glob_hits("f.[!o]", "f.c", "f.c")
+    assert not _glob_hits("f.[!o]", "f.o", "f.o")
+
+
+def test_glob_unclosed_bracket_is_literal() -> None:
+    assert _glob_hits("a[b", "a[b", "a[b")
+    assert not _glob_hits("a[b", "ab", "ab")
+
+
+def test_glob_matches_basename_fallback() -> None:
+    # _match_pattern_slow also tries the basename alone.
+    assert _glob_hits("*.rec-?", "/deep/nested/x.rec-1", "x.rec-1")
+
+
+# ── persisted warm-start cache ──────────────────────────────────────
+# save() dumps the built matcher arrays; load() mmaps them back and
+# re-attaches the rule objects in registration order.
+
+
+def _entry_rules(
+    rules: list[PatternRule],
+    additional_paths: list[tuple[str, PatternRule]] | None = None,
+) -> list[PatternRule]:
+    from dux.services.patterns import _native_ops
+
+    return [rule for _, _, _, rule, _ in _native_ops(rules, additional_paths)]
+
+
+def test_native_save_load_roundtrip(tmp_path: Path) -> None:
+    extra = _rule("cache-dir", "/home/u/.cache", InsightCategory.CACHE)
+    additional = [("/home/u/.cache", extra)]
+    native = compile_ruleset_native(_RULES, additional_paths=additional)
+    path = tmp_path / "ruleset.bin"
+    native.save(str(path))
+
+    loaded = CompiledRuleSetNative.load(str(path), _entry_rules(_RULES, additional))
+    probes = _PROBES + [("/home/u/.cache/pip/wheels", "wheels", False)]
+    for lpath, lbase, is_dir in probes:
+        assert loaded.match(lpath, lbase, is_dir) == native.match(lpath, lbase, is_dir), (
+            lpath,
+            is_dir,
+        )
+    # match_many exercises the GIL-released path over the mapped arrays.
+    assert loaded.match_many(list(probes)) == native.match_many(list(probes))
+
+
+def test_native_save_before_build_raises(tmp_path: Path) -> None:
+    rs = CompiledRuleSetNative()
+    with pytest.raises(RuntimeError, match="call build"):
+        rs.save(str(tmp_path / "ruleset.bin"))
+
+
+def test_native_load_rule_count_mismatch(tmp_path: Path) -> None:
+    native = compile_ruleset_native(_RULES)
+    path = tmp_path / "ruleset.bin"
+    native.save(str(path))
+    with pytest.raises(ValueError, match="rule count mismatch"):
+        CompiledRuleSetNative.load(str(path), [])
+
+
+def test_native_load_rejects_garbage(tmp_path: Path) -> None:
+    path = tmp_path / "ruleset.bin"
+    path.write_bytes(b"\x00" * 256)
+    with pytest.raises(ValueError, match="bad magic or truncated"):
+        CompiledRuleSetNative.load(str(path), [])
+    path.write_bytes(b"short")
+    with pytest.raises(OSError):
+        CompiledRuleSetNative.load(str(path), [])
+
+
+def test_compile_ruleset_native_cached_warm_start(tmp_path: Path) -> None:
+    from dux.services.patterns import compile_ruleset_native_cached
+
+    cold = compile_ruleset_native_cached(_RULES, cache_dir=str(tmp_path))
+    cached = list(tmp_path.glob("ruleset-*.bin"))
+    assert len(cached) == 1
+
+    warm = compile_ruleset_native_cached(_RULES, cache_dir=str(tmp_path))
+    for lpath, lbase, is_dir in _PROBES:
+        assert warm.match(lpath, lbase, is_dir) == cold.match(lpath, lbase, is_dir)
+
+
+def test_compile_ruleset_native_cached_keyed_on_rules(tmp_path: Path) -> None:
+    from dux.services.patterns import compile_ruleset_native_cached
+
+    compile_ruleset_native_cached(_RULES, cache_dir=str(tmp_path))
+    first = {p.name for p in tmp_path.glob("ruleset-*.bin")}
+    changed = [*_RULES, _rule("extra", "**/extra/**", InsightCategory.TEMP)]
+    rs = compile_ruleset_native_cached(changed, cache_dir=str(tmp_path))
+    # A config change misses the old key and recompiles; the stale cache
+    # file is swept on save, leaving only the current key behind.
+    second = {p.name for p in tmp_path.glob("ruleset-*.bin")}
+    assert len(second) == 1
+    assert second != first
+    assert len(rs.match("/a/extra/b", "b", True)) == 1
+
+
+def test_compile_ruleset_native_cached_survives_corrupt_cache(tmp_path: Path) -> None:
+    from dux.services.patterns import compile_ruleset_native_cached
+
+    compile_ruleset_native_cached(_RULES, cache_dir=str(tmp_path))
+    (cache_file,) = tmp_path.glob("ruleset-*.bin")
+    cache_file.write_bytes(b"not a ruleset cache, definitely")
+
+    rs = compile_ruleset_native_cached(_RULES, cache_dir=str(tmp_path))
+    py = compile_ruleset(_RULES)
+    for lpath, lbase, is_dir in _PROBES:
+        assert rs.match(lpath, lbase, is_dir) == match_all(py, lpath, lbase, is_dir)
+
+
+def test_glob_parity_with_python_fnmatch() -> None:
+    from fnmatch import fnmatch
+
+    patterns = ["a*b?c", "*.py[cod]", "x[!0-9]y", "[a-c][!x]*", "??", "*"]
+    probes = ["axxbyc", "m.pyc", "m.pyd", "xay", "x1y", "bz_long", "ab", "a", ""]
+    for pattern in patterns:
+        native = compile_ruleset_native([_rule("g", pattern, apply_to="file")])
+        for probe in probes:
+            expected = fnmatch(probe, pattern)
+            got = len(native.match(probe, probe, False)) == 1
+            assert got == expected, (pattern, probe)
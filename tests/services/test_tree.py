@@ -1,7 +1,8 @@
 from __future__ import annotations
 
 from dux.models.enums import NodeKind
-from dux.services.tree import iter_nodes, top_nodes
+from dux.models.scan import ScanNode
+from dux.services.tree import finalize_sizes, finalize_sizes_parallel, iter_nodes, top_nodes
 from tests.factories import make_dir, make_file
 
 
@@ -62,3 +63,63 @@ class TestTopNodes:
         root = make_dir("/r", du=100)
         result = top_nodes(root, 10, kind=None)
         assert len(result) == 0
+
+
+class TestFinalizeSizesParallel:
+    def _build_tree(self) -> ScanNode:
+        subtrees = []
+        for i in range(6):
+            files = [make_file(f"/r/d{i}/f{j}", du=(i + 1) * (j + 1)) for j in range(4)]
+            subtrees.append(make_dir(f"/r/d{i}", children=files))
+        top_file = make_file("/r/top.txt", du=7)
+        return make_dir("/r", children=[*subtrees, top_file])
+
+    def test_matches_serial_finalize(self) -> None:
+        serial = self._build_tree()
+        parallel = self._build_tree()
+        finalize_sizes(serial)
+        finalize_sizes_parallel(parallel, workers=4)
+
+        assert parallel.size_bytes == serial.size_bytes
+        assert parallel.disk_usage == serial.disk_usage
+        assert [c.name for c in parallel.children] == [c.name for c in serial.children]
+        assert [c.disk_usage for c in parallel.children] == [
+            c.disk_usage for c in serial.children
+        ]
+
+    def test_falls_back_to_serial_for_flat_trees(self) -> None:
+        f1 = make_file("/r/a", du=10)
+        root = make_dir("/r", children=[f1])
+        finalize_sizes_parallel(root, workers=8)
+        assert root.size_bytes == 10
+        assert root.disk_usage == 10
+
+    def test_single_worker(self) -> None:
+        tree = self._build_tree()
+        finalize_sizes_parallel(tree, workers=1)
+        assert tree.size_bytes == sum(c.size_bytes for c in tree.children)
+
+
+class TestExtensionTotals:
+    def test_groups_by_lowercased_extension(self) -> None:
+        from dux.services.tree import extension_totals
+
+        a = make_file("/r/a.LOG", du=10)
+        b = make_file("/r/b.log", du=20)
+        c = make_file("/r/archive.tar.gz", du=5)
+        root = make_dir("/r", du=35, children=[a, b, c])
+
+        totals = extension_totals(root)
+        assert totals["log"] == (2, 30, 30)
+        assert totals["gz"] == (1, 5, 5)
+
+    def test_extensionless_hidden_and_trailing_dot(self) -> None:
+        from dux.services.tree import extension_totals
+
+        plain = make_file("/r/Makefile", du=1)
+        hidden = make_file("/r/.bashrc", du=2)
+        trailing = make_file("/r/odd.", du=4)
+        root = make_dir("/r", du=7, children=[plain, hidden, trailing])
+
+        # None of these have an extension; directories are not counted.
+        assert extension_totals(root) == {"": (3, 7, 7)}
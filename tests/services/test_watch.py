@@ -0,0 +1,127 @@
+from __future__ import annotations
+
+import os
+import sys
+from pathlib import Path
+
+import pytest
+from result import Ok
+
+from dux.models.scan import ScanNode, ScanOptions
+from dux.scan.python_scanner import PythonScanner
+from dux.services.watch import WatchService
+
+pytestmark = pytest.mark.skipif(sys.platform != "linux", reason="inotify is Linux-only")
+
+# Generous: events are delivered as soon as the syscalls return, but the
+# sandbox can be slow to schedule the reader.
+_POLL_MS = 2000
+
+
+def _scan(path: Path) -> tuple[ScanNode, WatchService]:
+    result = PythonScanner(workers=1).scan(str(path), ScanOptions())
+    assert isinstance(result, Ok)
+    snapshot = result.unwrap()
+    return snapshot.root, WatchService(snapshot.root, snapshot.stats)
+
+
+def _child(node: ScanNode, name: str) -> ScanNode:
+    return next(c for c in node.children if c.name == name)
+
+
+def test_new_file_patches_sizes_up_the_chain(tmp_path: Path) -> None:
+    sub = tmp_path / "sub"
+    sub.mkdir()
+    (sub / "a.bin").write_bytes(b"x" * 4096)  # block-sized so disk usage differs
+
+    root, watch = _scan(tmp_path)
+    try:
+        old_root_size = root.size_bytes
+        (sub / "b.bin").write_bytes(b"y" * 4096 * 4)
+
+        changed = watch.poll(_POLL_MS)
+        assert str(sub) in changed
+        sub_node = _child(root, "sub")
+        assert sub_node.size_bytes == 4096 * 5
+        assert root.size_bytes == old_root_size + 4096 * 4
+        assert watch.stats.files == 2
+        # Finalize invariant: children stay sorted by disk usage.
+        assert [c.name for c in sub_node.children] == ["b.bin", "a.bin"]
+    finally:
+        watch.close()
+
+
+def test_deleted_file_and_quiet_poll(tmp_path: Path) -> None:
+    (tmp_path / "a.bin").write_bytes(b"x" * 100)
+    (tmp_path / "b.bin").write_bytes(b"y" * 50)
+
+    root, watch = _scan(tmp_path)
+    try:
+        assert watch.poll(0) == []  # nothing happened yet
+
+        os.unlink(tmp_path / "b.bin")
+        assert watch.poll(_POLL_MS) == [str(tmp_path)]
+        assert root.size_bytes == 100
+        assert watch.stats.files == 1
+        assert [c.name for c in root.children] == ["a.bin"]
+    finally:
+        watch.close()
+
+
+def test_new_subtree_is_scanned_and_watched(tmp_path: Path) -> None:
+    root, watch = _scan(tmp_path)
+    try:
+        deep = tmp_path / "new" / "deep"
+        deep.mkdir(parents=True)
+        (deep / "f.bin").write_bytes(b"z" * 200)
+
+        watch.poll(_POLL_MS)
+        new_node = _child(root, "new")
+        assert new_node.is_dir
+        assert new_node.size_bytes == 200
+        assert _child(new_node, "deep").size_bytes == 200
+        assert watch.stats.directories == 3
+
+        # The fresh directories must themselves be watched: a later
+        # write deep inside the new subtree has to come through.
+        (deep / "g.bin").write_bytes(b"w" * 100)
+        changed = watch.poll(_POLL_MS)
+        assert str(deep) in changed
+        assert new_node.size_bytes == 300
+        assert root.size_bytes == 300
+    finally:
+        watch.close()
+
+
+def test_removed_subtree_is_dropped_and_unwatched(tmp_path: Path) -> None:
+    sub = tmp_path / "sub"
+    sub.mkdir()
+    (sub / "a.bin").write_bytes(b"x" * 100)
+
+    root, watch = _scan(tmp_path)
+    try:
+        os.unlink(sub / "a.bin")
+        os.rmdir(sub)
+
+        watch.poll(_POLL_MS)
+        assert root.size_bytes == 0
+        assert root.children == []
+        assert watch.stats.files == 0
+        assert watch.stats.directories == 1  # just the root
+    finally:
+        watch.close()
+
+
+def test_file_size_change_updates_in_place(tmp_path: Path) -> None:
+    target = tmp_path / "grow.log"
+    target.write_bytes(b"x" * 10)
+
+    root, watch = _scan(tmp_path)
+    try:
+        target.write_bytes(b"x" * 512)
+        watch.poll(_POLL_MS)
+        assert root.size_bytes == 512
+        assert _child(root, "grow.log").size_bytes == 512
+        assert watch.stats.files == 1
+    finally:
+        watch.close()